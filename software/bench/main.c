@@ -0,0 +1,188 @@
+/*
+ * bench: count the cycles taken by the timer interrupt handlers and the
+ * pid2 control steps.
+ *
+ * Copyright 2014-2017 Glen Overby
+ * 
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * This is meant to be run in the mspdebug simulator by run.sh.  Timer 1
+ * counts SMCLK (which is MCLK) and is used as the cycle counter.  The
+ * interrupt handlers are entered the way the CPU enters them: PC and SR are
+ * pushed and the handler returns with RETI.
+ *
+ * The results are left in bench_result[], and the program stops in
+ * bench_done().  Each result is the largest cycle count seen for that path.
+ *
+ * Under the simulator the serial port is always ready, so the cycle counts
+ * for the control steps include the cost of formatting the output but not
+ * of waiting for it to be sent.
+ */
+
+#include "gpsdo.h"
+#include "pid2.h"
+
+// Results, in cycles.  run.sh knows this order.
+#define R_OVERFLOW      0       // Timer_A: counter overflow
+#define R_CAPTURE       1       // Timer_A0: 1PPS capture
+#define R_POLL          2       // control_poll() in an operational state
+#define R_FASTSAMPLE    3       // control_pps() in FAST, counting
+#define R_FASTSTEP      4       // control_pps() in FAST, adjusting and printing
+#define R_SLOWSAMPLE    5       // control_pps() in SLOW, counting
+#define R_SLOWSTEP      6       // control_pps() in SLOW, adjusting and printing
+#define R_COUNT         7
+
+unsigned int bench_result[R_COUNT];
+
+// Cycles of an empty interrupt handler: the measurement overhead and RETI.
+static unsigned int isr_base;
+
+void Timer_A (void);
+void Timer_A0 (void);
+
+ISR(PORT1_VECTOR, bench_empty_isr)
+{
+}
+
+//
+// Board interface for the control state machine
+//
+void
+ledstate(int blue, int green, int yellow)
+{
+}
+
+int
+osc_cold(void)
+{
+    return 0;
+}
+
+int
+gps_nolock(void)
+{
+    return 0;
+}
+
+#if TUNABLE
+int
+tune_load (struct tune *t)
+{
+    return 0;
+}
+
+void
+tune_save (const struct tune *t)
+{
+}
+#endif
+
+// Breakpoint for run.sh
+void __attribute__((noinline))
+bench_done(void)
+{
+    for (;;);
+}
+
+//
+// Enter an interrupt handler as the CPU would, and count its cycles.
+// The result includes 6 cycles of interrupt acceptance and the RETI.
+//
+static unsigned int
+isr_cycles(void (*isr)(void))
+{
+    unsigned int t;
+
+    t = TA1R;
+    __asm__ __volatile__ (
+        "push   #1f\n\t"
+        "push   r2\n\t"
+        "br     %0\n"
+        "1:\n"
+        : : "r" (isr) : "memory");
+    t = TA1R - t;
+    return t - isr_base + 5 + 6;
+}
+
+static void
+record(int r, unsigned int cycles)
+{
+    if (cycles > bench_result[r])
+        bench_result[r] = cycles;
+}
+
+//
+// Run the control state machine for one second with the given count and
+// record the cycles used for the state it was in.
+//
+static void
+second(long c)
+{
+    char s = state;
+    unsigned int t;
+    int step;
+
+    t = TA1R;
+    control_poll();
+    t = TA1R - t;
+    if (s >= FASTINIT)
+        record(R_POLL, t);
+
+    t = TA1R;
+    step = control_pps(c);
+    t = TA1R - t;
+
+    if (s == FAST)
+        record(step ? R_FASTSTEP : R_FASTSAMPLE, t);
+    else if (s == SLOW)
+        record(step ? R_SLOWSTEP : R_SLOWSAMPLE, t);
+}
+
+int
+main (void)
+{
+    int i;
+
+    clock_init();
+    pwm_init(1);                // Timer 1 counts MCLK: the cycle counter
+    IFG2 |= UCA0TXIFG;          // the simulator has no serial port
+
+    isr_base = 0;
+    isr_base = isr_cycles(bench_empty_isr) - 5 - 6;
+
+    // Counter overflow
+    for (i = 0; i < 4; i++) {
+        TA0IV = 10;
+        record(R_OVERFLOW, isr_cycles(Timer_A));
+    }
+
+    // 1PPS capture, with and without a capture overflow
+    for (i = 0; i < 4; i++) {
+        TA0CCR0 = 0x9680 + i;
+        TA0CCTL0 = CM1 | SCS | CAP | CCIE | ((i & 1) ? COV : 0);
+        record(R_CAPTURE, isr_cycles(Timer_A0));
+    }
+
+    //
+    // Drive the control state machine from start through FAST and into SLOW
+    // with a count 1 hz high, then 1 hz low, so both make adjustments.
+    //
+    control_init(PWM_START);
+    for (i = 0; i < 600 && state != SLOW; i++)
+        second(i < 40 ? 10000000 + 1 : 10000000);
+    for (i = 0; i < 180; i++)
+        second(i < 90 ? 10000000 - 1 : 10000000);
+
+    bench_done();
+    return 0;
+}
@@ -0,0 +1,85 @@
+#!/bin/sh
+#
+# Run the cycle count benchmark in the mspdebug simulator, report the
+# results, and append them to the history in cycles.log.
+#
+# usage: run.sh bench.elf [cycles.log]
+#
+# Exits with status 1 if any result is more than BENCH_TOLERANCE percent
+# (default 5) above the previous entry in the log.
+#
+
+ELF=${1:-build/bench.elf}
+LOG=${2:-`dirname $0`/cycles.log}
+TOLERANCE=${BENCH_TOLERANCE:-5}
+MSPDEBUG=${MSPDEBUG:-mspdebug}
+
+# Names of bench_result[], in order
+NAMES="overflow-isr capture-isr poll fast-sample fast-step slow-sample slow-step"
+N=`echo $NAMES | wc -w`
+
+# Timer 1 is simulated so it can be used as the cycle counter.  The
+# simulator's info flash is erased, and clock_init() stops on an erased
+# DCO calibration, so the 16 MHz constants (CALDCO_16MHZ at 0x10f8,
+# CALBC1_16MHZ at 0x10f9) are loaded after the program.  The simulator
+# doesn't model the DCO, so their values only need to be other than 0xff.
+out=`$MSPDEBUG -q sim \
+    "prog $ELF" \
+    "mw 0x10f8 0x8e 0x8f" \
+    "simio add timer ta1 3" \
+    "simio config ta1 base 0x0180" \
+    "simio config ta1 iv 0x011e" \
+    "setbreak bench_done" \
+    "run" \
+    "md bench_result $((N * 2))"` || exit 2
+
+# md prints "    addr: xx xx ... |text|".  Take the bytes as little-endian words.
+results=`echo "$out" | awk -v n=$N '
+    function hex(s,  i, v) {
+        v = 0
+        for (i = 1; i <= length(s); i++)
+            v = v * 16 + index("0123456789abcdef", tolower(substr(s, i, 1))) - 1
+        return v
+    }
+    /^ *[0-9a-fA-F]+:/ {
+        sub(/\|.*/, "")
+        for (i = 2; i <= NF; i++)
+            if ($i ~ /^[0-9a-fA-F][0-9a-fA-F]$/)
+                b[nb++] = $i
+    }
+    END {
+        if (nb < n * 2)
+            exit 1
+        for (i = 0; i < n; i++)
+            printf "%d ", hex(b[i*2+1]) * 256 + hex(b[i*2])
+    }'` || {
+    echo "bench: no results from the simulator" >&2
+    echo "$out" >&2
+    exit 2
+}
+
+last=`grep -v '^#' $LOG 2>/dev/null | tail -1 | cut -d' ' -f3-`
+
+echo "$NAMES" "$results" "$last" | awk -v n=$N -v tol=$TOLERANCE '
+    {
+        printf "%-14s %8s %8s\n", "path", "cycles", "change"
+        status = 0
+        for (i = 1; i <= n; i++) {
+            name = $i; c = $(n + i); p = $(2 * n + i)
+            if (p == "") {
+                printf "%-14s %8d\n", name, c
+            } else {
+                printf "%-14s %8d %+8d\n", name, c, c - p
+                if (c > p + p * tol / 100)
+                    status = 1
+            }
+        }
+        if (status)
+            print "bench: cycle count regression"
+        exit status
+    }'
+status=$?
+
+[ -f $LOG ] || echo "# date commit $NAMES" > $LOG
+echo `date +%Y-%m-%d` `git describe --always --dirty 2>/dev/null || echo -` $results >> $LOG
+exit $status
@@ -0,0 +1,200 @@
+/*
+ * config.c - Configure the microcontroller clock, counter, PWM and serial port
+ *
+ * Copyright 2014-2017 Glen Overby
+ * 
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gpsdo.h"
+
+//
+// Stop the watchdog and set processor clock speed
+// From TI's example program: msp430g2xx3_dco_calib
+//
+void
+clock_init (void)
+{
+    WDTCTL = WDTPW | WDTHOLD;   // Stop watchdog timer
+
+#if CPU_MHZ == 12
+    if (CALBC1_12MHZ == 0xFF)   // If calibration constant erased
+        for (;;);               // do not load, trap CPU!!
+    DCOCTL = 0;                 // Select lowest DCOx and MODx settings
+    BCSCTL1 = CALBC1_12MHZ;     // Set range
+    DCOCTL = CALDCO_12MHZ;      // Set DCO step + modulation
+#elif CPU_MHZ == 16
+    if (CALBC1_16MHZ == 0xFF)   // If calibration constant erased
+        for (;;);               // do not load, trap CPU!!
+    DCOCTL = 0;                 // Select lowest DCOx and MODx settings
+    BCSCTL1 = CALBC1_16MHZ;     // Set range
+    DCOCTL = CALDCO_16MHZ;      // Set DCO step + modulation
+#else
+#error "CPU_MHZ must be 12 or 16"
+#endif
+}
+
+//
+// Start the watchdog, clocked by ACLK from the VLO so it doesn't depend on a
+// crystal or on the DCO.  With WDT_TICK, the watchdog timer is the tick
+// instead, on SMCLK, and the reset is counted in ticks (counter.c).
+//
+void
+watchdog_init (void)
+{
+#if WDT_TICK
+    watchdog_clear();
+    WDTCTL = WDT_MDLY_32;       // interval of TICK_CLOCKS SMCLK clocks
+    IE1 |= WDTIE;
+#else
+    BCSCTL3 = (BCSCTL3 & ~LFXT1S_3) | LFXT1S_2;        // ACLK from the VLO
+    watchdog_clear();
+#endif
+}
+
+//
+// Configure Timer TA0 to count clock pulses on P1.0 with a capture input on P1.1.
+// From TI's example program: msp430g2xx3_ta_03.c (with modifications)
+//
+void
+counter_init (void)
+{
+    TA0CTL = MC_2 + TAIE;       // TACLK, continuous mode, interrupt
+    P1SEL |= 0x01;              // Function: TA0.TACLK
+
+    // Enable Capture/Compare register 0
+#if PPS_VALIDATE
+    TA0CCTL0 = CM_3 | SCS | CAP | CCIE; // Capture on CCIxA on both edges, synchronous
+#else
+    TA0CCTL0 = CM1 | SCS | CAP | CCIE;  // Capture on CCIxA on falling edge, synchronous
+#endif
+#if PPS_OUT
+    TA0CCTL1 = OUTMOD_0;        // 1PPS output, low until the handlers arm it
+    P1DIR |= BIT6;              // output
+    P1SEL |= BIT6;              // Function: TA0.1
+    P1SEL2 &= ~BIT6;
+#elif COMPARE_INPUT
+    // Comparison input on P1.3 (CA3) to the comparator's - input, half Vcc
+    // to its +, so its output falls as the input rises
+    CAPD |= CAPD3;              // P1.3 input buffer off
+    CACTL2 = P2CA2 | P2CA1 | CAF;       // CA3 to -, filtered output
+    CACTL1 = CAREF_2 | CAON;    // 0.5 Vcc to +
+    TA0CCTL1 = CM_2 | CCIS_1 | SCS | CAP | CCIE;       // capture CAOUT (CCI1B), falling edge
+#else
+    TA0CCTL1 = 0;
+#endif
+    TA0CCTL2 = 0;               // 1PPS watchdog, armed by the handlers
+
+    P1DIR &= ~0x02;             // input
+    P1SEL |= 0x02;              // Function: CCI0A
+
+#if !WDT_TICK
+    TA1CCTL0 = CCIE;            // oscillator watchdog, on timer 1's period (pwm_init)
+#endif
+}
+
+#if !SPI_DAC
+//
+// PWM using timer 1 on P2.2
+// This goes through a low-pass filter and connects to the oscillator's voltage
+// control input.
+// From TI's example program: msp430g2xx3_ta_16.c (with modifications)
+//
+void
+pwm_init (unsigned int duty)
+{
+    P2DIR |= 0x04;              // P2.2 output
+    P2SEL |= 0x04;              // P2.2 TA1 options
+#if DUAL_PWM
+    P2DIR |= 0x10;              // P2.4 output, the fine PWM
+    P2SEL |= 0x10;              // P2.4 TA1 options
+    P2SEL2 &= ~0x10;
+    TA1CCR0 = DUAL_PERIOD - 1;  // PWM Period
+    TA1CCTL2 = OUTMOD_7;        // CCR2 reset/set
+#else
+    TA1CCR0 = 65535;            // PWM Period
+#endif
+    TA1CCTL1 = OUTMOD_7;        // CCR1 reset/set
+    pwm_set(duty);              // CCR1 (and CCR2) PWM duty cycle
+#if OSC_CLOCK
+    P2DIR &= ~BIT6;             // P2.6 input
+    P2SEL |= BIT6;              // Function: XIN
+    P2SEL2 &= ~BIT6;
+    BCSCTL3 = LFXT1S_3;         // ACLK from an external clock on XIN
+    TA1CTL = TASSEL_1 + MC_1;   // ACLK, up mode - counts to TA1CCR0
+#else
+    TA1CTL = TASSEL_2 + MC_1;   // SMCLK, up mode - counts to TA1CCR0
+#endif
+}
+
+// Set the PWM duty cycle.  With DUAL_PWM, the high byte is the coarse PWM
+// and the low byte, scaled to the fine PWM's DUAL_FINE_STEP counts a coarse
+// step, the fine.
+void
+pwm_set (unsigned int duty)
+{
+#if DUAL_PWM
+    TA1CCR1 = duty >> 8;
+    TA1CCR2 = (duty & 0xff) * DUAL_FINE_STEP >> 8;
+#else
+    TA1CCR1 = duty;
+#endif
+}
+#endif /* !SPI_DAC */
+
+//
+// Serial port divisor for BAUD, from SMCLK (the DCO), in oversampling mode:
+// a bit is 16 BITCLK16s of UCBR clocks, plus UCBRF clocks spread over them,
+// so the bit is UART_N clocks on average, the clock rounded to sixteenths of
+// a UCBR.  The error is that of the average rate, in hundredths of a percent.
+//
+#define UART_CLK        (CPU_MHZ * 1000000L)
+#define UART_N          ((UART_CLK + BAUD / 2) / BAUD)  // clocks a bit
+#define UART_BR         (UART_N / 16)
+#define UART_BRF        (UART_N % 16)
+#define UART_ERROR      ((UART_CLK - UART_N * BAUD) * 10000 / (UART_N * BAUD))
+#define UART_MAX_ERROR  200     // 2%, about half of a receiver's margin
+
+#if UART_BR < 1
+#error "BAUD is too fast for CPU_MHZ"
+#elif UART_BR > 65535
+#error "BAUD is too slow for CPU_MHZ"
+#elif UART_ERROR > UART_MAX_ERROR || UART_ERROR < -UART_MAX_ERROR
+#error "BAUD can't be made from CPU_MHZ closely enough"
+#endif
+
+//
+// Serial port from TI's example program: msp430g2xx3_uscia0_uart_01_9600 (modified)
+// Transmit only (rx.c receives).  A '!' is sent to mark a reset.
+//
+void
+uart_init (void)
+{
+    P1SEL |= BIT2;              // P1.2=TXD
+    P1SEL2 |= BIT2;             // P1.2=TXD
+    UCA0CTL1 |= UCSSEL_2;       // Uart clock from SMCLK
+    UCA0BR0 = UART_BR & 0xff;   // BAUD from CPU_MHZ
+    UCA0BR1 = UART_BR >> 8;
+    UCA0MCTL = UART_BRF * UCBRF0 | UCOS16;     // Modulation UCBRFx, oversampling
+    UCA0CTL1 &= ~UCSWRST;       // **Initialize USCI state machine**
+
+    UCA0TXBUF = '!';
+}
+
+// blocking character transmit.
+void
+tx (char c)
+{
+    while (!(IFG2 & UCA0TXIFG));        // USCI_A0 TX buffer ready?
+    UCA0TXBUF = c;              // TX -> character
+}
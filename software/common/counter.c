@@ -0,0 +1,446 @@
+/*
+ * counter.c - Count the 10mhz oscillator and capture the count at each 1PPS
+ *
+ * Copyright 2014-2017 Glen Overby
+ * 
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Timer 0 counts the oscillator on TACLK.  The overflow interrupt counts
+ * timer wraps in 'wraps', and the 1PPS capture interrupt assembles the 32-bit
+ * count for the last second from the wraps and captured timer values since
+ * the previous 1PPS, and puts it into 'capture'.  The main loop polls
+ * 'capture' and sets it back to 0 when it has been used.
+ *
+ * The overflow interrupt runs about 150 times a second, so it only does a
+ * 16-bit increment; the 32-bit arithmetic is done once a second.
+ *
+ * The 1PPS watchdog is compare register 2, set to fire PPS_TIMEOUT counts
+ * after each 1PPS capture.  That is more than 16 bits of counts, so the
+ * capture works out the wrap and timer value of the timeout, and the
+ * overflow interrupt arms the compare in that wrap.  (A timeout within a
+ * few counts of the wrap is caught a wrap, 6.5ms, late.)  The oscillator
+ * watchdog can't use timer 0, which stops with the oscillator: it runs from
+ * timer 1's period interrupt, which is clocked by the DCO, or with
+ * WDT_TICK (timer 1 on the oscillator, or too fast) from the watchdog
+ * timer's.
+ *
+ * With PPS_OUT, compare register 1 makes the 1PPS output's edges in its
+ * output unit, so they don't wait on the interrupt handlers.  The overflow
+ * interrupt arms each edge in its wrap the same way, but an edge in the
+ * first half of its wrap is armed from a compare half way through the wrap
+ * before, so the compare is set while the timer is past it and can't be
+ * missed.  The handler for the falling edge works out the next second.
+ * With PPS_VALIDATE, the 1PPS capture interrupt comes on both edges.  The
+ * falling edge's wrap and timer value are kept, and the rising edge takes
+ * them as the second's if the pulse is good (gpsdo.h); a falling edge has
+ * no other work to do.
+ *
+ * With COMPARE_INPUT, compare register 1 captures the comparison input
+ * instead, and its wrap is worked out as the 1PPS capture's is.
+ */
+
+#include "gpsdo.h"
+
+volatile uint16_t wraps = 0;             // counter overflows.  Managed by counter overflow interrupt handler
+volatile uint16_t ppswraps = 0;          // value of wraps at the last 1pps capture
+static uint16_t ppscount = 0;            // timer value at the last 1pps capture
+volatile long capture = 0;               // captured count
+volatile char pps = 0;                   // 1pps captures.  p/main.c checks it for no 10mhz clock; pid2 uses LOST_OSC
+volatile char lost = 0;                  // LOST_PPS, LOST_OSC: signals missing
+volatile uint16_t ticks = 0;             // TICK_CLOCKS periods
+#if WDT_TICK
+volatile uint16_t watchdog_ticks = 0;    // ticks since watchdog_clear()
+#endif
+
+#define PPS_TIMEOUT     (PPS_HOLDOFF * 10000000UL)      // oscillator counts
+#define OSC_TIMEOUT     (TICKS_MS(OSC_HOLDOFF) + 1)     // ticks
+#if PPS_TIMEOUT >> 16 >= 65536
+#error "PPS_HOLDOFF is too long for the wrap counter"
+#endif
+
+// The timeout, from when the timer starts until the first 1PPS
+static uint16_t ppsdue = (uint16_t) (PPS_TIMEOUT >> 16);       // wraps at the 1PPS timeout
+static uint16_t ppsduecount = (uint16_t) PPS_TIMEOUT;          //   and the timer value
+
+#if COMPARE_INPUT
+static uint32_t cmptime;                 // last comparison input edge, wraps << 16 | timer value
+static char cmpnew;                      // cmptime is new since cmp_report()
+#endif
+
+#if PPS_OUT
+volatile long ppsout = 0;                // output edge - GPS 1PPS, counts
+volatile char ppsout_steered = 0;        // ppsout is from the last output edge
+static uint16_t outdue = 2;              // wraps at the next output edge
+static uint16_t outduecount = 0;         //   and the timer value
+static unsigned int outmode = OUTMOD_1;  // the edge: OUTMOD_1 rising, OUTMOD_5 falling
+static char outhalf;                     // compare 1 is half way through the wrap before
+static uint32_t outrise;                 // the last rising edge, wraps << 16 | timer value
+static long outacc;                      // offset not yet corrected, << PPS_OUT_SHIFT
+static char outgps;                      // a 1PPS was captured since the last falling edge
+static char outstepped;                  // the first offset has been stepped out
+#endif
+
+#ifdef ISR_STATS
+volatile struct isrstats isrstats = { 0xffff, 0 };
+#endif
+
+#if PPS_VALIDATE
+#define PPS_MIN_COUNTS  (PPS_MIN_WIDTH * 10L)           // oscillator counts
+#define PPS_MAX_COUNTS  (PPS_MAX_WIDTH * 10000L)
+volatile struct ppsstats ppsstats;
+static uint16_t fallwraps;       // wraps at the last falling edge
+static uint16_t fallcount;       //   and the timer value
+static char falling;             // a falling edge is waiting for its rising edge
+static char ppstaken;            // a second has been taken
+#endif
+
+#if PPS_OUT
+// Schedule the output's next rising edge, a second after the last, less a
+// part of its offset from the GPS 1PPS captured since the last second.
+// The 1PPS may come up to 0.9 seconds before the edge or 0.1 after, so an
+// offset of over half a second is from the next second's 1PPS.
+static void
+pps_out_next (void)
+{
+    uint32_t next;
+    long e, c = 0;
+
+    ppsout_steered = outgps;
+    if (outgps) {
+        outgps = 0;
+        e = (int32_t) (outrise - ((uint32_t) ppswraps << 16 | ppscount));
+        if (e > 5000000)
+            e -= 10000000;
+        else if (e < -5000000)
+            e += 10000000;
+        ppsout = e;
+        if (!outstepped) {
+            outstepped = 1;
+            c = e;
+        } else {
+            outacc += e;
+            c = (outacc + (1 << (PPS_OUT_SHIFT - 1))) >> PPS_OUT_SHIFT;
+            if (c > PPS_OUT_SLEW || c < -PPS_OUT_SLEW) {
+                c = c > 0 ? PPS_OUT_SLEW : -PPS_OUT_SLEW;
+                outacc = 0;
+            } else {
+                outacc -= c * (1L << PPS_OUT_SHIFT);
+            }
+        }
+    }
+    next = outrise + 10000000 - c;
+    outdue = next >> 16;
+    outduecount = next;
+    outmode = OUTMOD_1;
+}
+#endif
+
+// From TI's example program: msp430g2xx3_ta_03.c (with modifications)
+// Timer_A3 Interrupt Vector (TA0IV) handler
+// The 10mhz clock is to be connected to it's count input.
+ISR(TIMER0_A1_VECTOR, Timer_A)
+{
+#if COMPARE_INPUT
+    uint16_t c, w;
+#endif
+
+    switch (TA0IV) {
+#if COMPARE_INPUT
+    case 2:                     // capture 1: the comparison input
+        c = TA0CCR1;
+        TA0CCTL1 &= ~COV;
+        w = wraps;
+        if ((TA0CTL & TAIFG) && c < 0x8000)
+            w++;                // as in the 1PPS capture
+        cmptime = (uint32_t) w << 16 | c;
+        cmpnew = 1;
+        break;
+#endif
+#if PPS_OUT
+    case 2:                     // compare 1: the 1PPS output
+        if (outhalf) {
+            outhalf = 0;
+            TA0CCR1 = outduecount;      // the timer is past it: the next wrap
+            TA0CCTL1 = outmode | CCIE;
+        } else if (outmode == OUTMOD_1) {
+            TA0CCTL1 = OUTMOD_1;        // rose
+            outrise = (uint32_t) outdue << 16 | outduecount;
+            outdue += PPS_OUT_WIDTH;
+            outmode = OUTMOD_5;
+        } else {
+            TA0CCTL1 = OUTMOD_5;        // fell
+            pps_out_next();
+        }
+        break;
+#endif
+    case 4:                     // compare 2: no 1PPS for PPS_TIMEOUT counts
+        TA0CCTL2 = 0;
+        lost |= LOST_PPS;
+        break;
+    case 10:                    // counter overflow
+        wraps++;
+        if (wraps == ppsdue && !(lost & LOST_PPS)) {
+            TA0CCR2 = ppsduecount;
+            TA0CCTL2 = CCIE;
+        }
+#if PPS_OUT
+        if (wraps == outdue && outduecount >= 0x8000) {
+            TA0CCR1 = outduecount;
+            TA0CCTL1 = outmode | CCIE;
+        } else if ((uint16_t) (wraps + 1) == outdue && outduecount < 0x8000) {
+            TA0CCR1 = 0x8000;
+            TA0CCTL1 = (TA0CCTL1 & OUTMOD_7) | CCIE;   // holding the output
+            outhalf = 1;
+        }
+#endif
+        break;
+    }
+}
+
+// Interrupt vector for capture/compare register 0
+// 1PPS is to be connected here.
+ISR(TIMER0_A0_VECTOR, Timer_A0)
+{
+    uint16_t c, w;
+#if PPS_VALIDATE
+    long width;
+#endif
+#ifdef ISR_STATS
+    uint16_t r = TA0R;          // counter at entry, for the latency
+#endif
+    c = TA0CCR0;                // get capture value
+#ifdef ISR_STATS
+    r -= c;
+    if (r < isrstats.lat_min)
+        isrstats.lat_min = r;
+    if (r > isrstats.lat_max)
+        isrstats.lat_max = r;
+    r >>= ISR_HIST_SHIFT;
+    if (r >= ISR_HIST)
+        r = ISR_HIST - 1;
+    isrstats.lat_hist[r]++;
+    if (TA0CCTL0 & COV)         // a second capture before this one was read
+        isrstats.cov++;
+    if (TA0CTL & TAIFG)         // counter overflow waiting behind this capture
+        isrstats.wrap++;
+#endif
+    TA0CCTL0 &= ~COV;           // If there has been an overflow, reset it
+
+    // This interrupt has priority over the counter overflow.  If an overflow
+    // is still pending and the captured value is small, the counter wrapped
+    // before the capture and that wrap belongs to this second.  The overflow
+    // handler will count it in 'wraps' when it runs.
+    w = wraps;
+    if ((TA0CTL & TAIFG) && c < 0x8000)
+        w++;
+
+#if PPS_VALIDATE
+    // The input is still low after a falling edge, as the pulse is longer
+    // than this handler's latency; a narrower glitch looks like two rising
+    // edges, and is dropped.
+    if (!(TA0CCTL0 & CCI)) {
+        fallwraps = w;
+        fallcount = c;
+        falling = 1;
+        return;
+    }
+    if (!falling)
+        return;
+    falling = 0;
+    width = ((long) (uint16_t) (w - fallwraps) << 16) + c - fallcount;
+    if (width < PPS_MIN_COUNTS) {
+        ppsstats.narrow++;
+        return;
+    }
+    if (width > PPS_MAX_COUNTS) {
+        ppsstats.wide++;
+        return;
+    }
+    w = fallwraps;
+    c = fallcount;
+    if (ppstaken && (uint16_t) (w - ppswraps) < PPS_MIN_PERIOD) {
+        ppsstats.twice++;
+        return;
+    }
+    ppstaken = 1;
+    ppsstats.good++;
+#endif
+
+    capture = ((long) (uint16_t) (w - ppswraps) << 16) + c - ppscount;
+    ppswraps = w;
+    ppscount = c;
+
+    // Restart the 1PPS watchdog
+    TA0CCTL2 = 0;
+    ppsduecount = c + (uint16_t) PPS_TIMEOUT;
+    ppsdue = w + (uint16_t) (PPS_TIMEOUT >> 16) + (ppsduecount < c);
+    lost &= ~LOST_PPS;
+#if PPS_OUT
+    outgps = 1;
+#endif
+
+    pps++;                      // 1pps counter
+}
+
+// Timer 1's period (the watchdog timer's interval with WDT_TICK): the
+// tick, and the oscillator watchdog, OSC_TIMEOUT ticks making OSC_HOLDOFF.
+// Timer 0 is read while it counts on its own clock, so the value may be
+// off, but it won't be the same twice unless it has stopped.
+#if WDT_TICK
+ISR(WDT_VECTOR, watchdog_tick)
+#else
+ISR(TIMER1_A0_VECTOR, Timer1_A0)
+#endif
+{
+    static unsigned int last;   // timer 0 at the last period
+    static unsigned int same;   // periods it has been the same
+    unsigned int r = TA0R;
+
+    ticks++;
+#if WDT_TICK
+    // the watchdog reset: a write without the password resets the
+    // processor, with WDTIFG set as a timeout would
+    if (++watchdog_ticks >= WATCHDOG_TICKS)
+        WDTCTL = 0;
+#endif
+
+    if (r != last) {
+        last = r;
+        same = 0;
+        lost &= ~LOST_OSC;
+    } else if (same < OSC_TIMEOUT && ++same == OSC_TIMEOUT) {
+        lost |= LOST_OSC;
+    }
+}
+
+#ifdef ISR_STATS
+//
+// Report and reset the capture interrupt statistics:
+// ## lat <min> <max> <histogram...> cov <n> wrap <n>
+// Latencies are in oscillator counts from the 1PPS edge to the handler.
+//
+void
+isr_report (void)
+{
+    struct isrstats s;
+    int i;
+
+    _BIC_SR (GIE);
+    s = isrstats;
+    isrstats.lat_min = 0xffff;
+    isrstats.lat_max = 0;
+    for (i = 0; i < ISR_HIST; i++)
+        isrstats.lat_hist[i] = 0;
+    isrstats.cov = isrstats.wrap = 0;
+    _BIS_SR (GIE);
+
+    printfs ("## lat ");
+    printfld (s.lat_min);
+    tx (' ');
+    printfld (s.lat_max);
+    for (i = 0; i < ISR_HIST; i++) {
+        tx (' ');
+        printfld (s.lat_hist[i]);
+    }
+    printfs (" cov ");
+    printfld (s.cov);
+    printfs (" wrap ");
+    printfld (s.wrap);
+    nl ();
+}
+#endif
+
+#if PPS_VALIDATE
+//
+// Report and reset the 1PPS validation counts:
+// ## pps <good> narrow <n> wide <n> twice <n>
+//
+void
+pps_report (void)
+{
+    struct ppsstats s;
+
+    _BIC_SR (GIE);
+    s = ppsstats;
+    ppsstats.good = ppsstats.narrow = ppsstats.wide = ppsstats.twice = 0;
+    _BIS_SR (GIE);
+
+    printfs ("## pps ");
+    printfld (s.good);
+    printfs (" narrow ");
+    printfld (s.narrow);
+    printfs (" wide ");
+    printfld (s.wide);
+    printfs (" twice ");
+    printfld (s.twice);
+    nl ();
+}
+#endif
+
+#if COMPARE_INPUT
+//
+// Report the comparison input's offset from the GPS 1PPS just captured, in
+// oscillator counts, or - if it had no edge since the last report:
+// ## cmp <offset>
+// Called once a second, after the 1PPS capture.
+//
+void
+cmp_report (void)
+{
+    long d;
+    char n;
+
+    _BIC_SR (GIE);
+    n = cmpnew;
+    cmpnew = 0;
+    d = (int32_t) (cmptime - ((uint32_t) ppswraps << 16 | ppscount));
+    _BIS_SR (GIE);
+
+    printfs ("## cmp ");
+    if (!n) {
+        tx ('-');
+    } else {
+        if (d > 5000000)        // the edge is nearer the next second's 1PPS
+            d -= 10000000;
+        else if (d < -5000000)
+            d += 10000000;
+        printfld (d);
+    }
+    nl ();
+}
+#endif
+
+#if PPS_OUT
+//
+// Report the 1PPS output's last offset from the GPS 1PPS, in oscillator
+// counts, late positive:
+// ## ppsout <offset> [holdover]
+//
+void
+ppsout_report (void)
+{
+    long e;
+    char steered;
+
+    _BIC_SR (GIE);
+    e = ppsout;
+    steered = ppsout_steered;
+    _BIS_SR (GIE);
+
+    printfs ("## ppsout ");
+    printfld (e);
+    if (!steered)
+        printfs (" holdover");
+    nl ();
+}
+#endif
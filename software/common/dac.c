@@ -0,0 +1,157 @@
+/*
+ * dac.c - Tuning voltage from an SPI DAC on USCI_B0, in place of the PWM
+ *
+ * Copyright 2014-2017 Glen Overby
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Built with -DSPI_DAC=1, pwm_init() and pwm_set() drive a 16 or 20 bit
+ * DAC (DAC_BITS) instead of timer 1's PWM, which is left running for the
+ * tick.  The duty cycle is mapped to a DAC code by DAC_CODE().
+ *
+ * P1.5 UCB0CLK to the DAC's SCLK
+ * P1.7 UCB0SIMO to the DAC's SDIN
+ * P2.3 chip select (SYNC), low for each frame; the DAC's LDAC tied low so
+ *      the code is loaded when it goes high
+ *
+ * A frame is sent from the USCI's receive interrupt, which comes as each
+ * byte finishes shifting out: pwm_set() sends the first byte and returns,
+ * the handler sends the rest and raises chip select after the last.  A
+ * code set while a frame is going out is sent after it.
+ */
+
+#include "gpsdo.h"
+
+#if SPI_DAC
+
+#define DAC_CS          0x08    // P2.3
+
+#if DAC_BITS == 16
+// 16 bits of code, as the AD5541 and DAC8830, taken on SCLK's rising edge
+#define DAC_BYTES       2
+#define DAC_FRAME(c)    (c)
+#define DAC_PHASE       UCCKPH
+#elif DAC_BITS == 20
+// 4 bits of register and 20 of code, as the AD5791: the DAC register is 1,
+// the control register 2.  The control register is set to binary offset
+// codes, with the output no longer clamped to ground.  Bits are taken on
+// SCLK's falling edge.
+#define DAC_BYTES       3
+#define DAC_FRAME(c)    (0x100000UL | (c))
+#define DAC_PHASE       0
+#define DAC_CONTROL     0x200012UL      // RBUF, BIN/2sC
+#else
+#error "DAC_BITS must be 16 or 20"
+#endif
+
+static volatile uint32_t dac_code;      // code to send
+static volatile char dac_new;   // dac_code is waiting for the frame being sent
+static volatile char dac_busy;  // a frame is being sent
+static unsigned char dac_buf[DAC_BYTES];        // the frame, the first byte first
+static volatile unsigned char dac_i;    // next byte of dac_buf to send
+
+// Start sending dac_code.  Called with interrupts off, or from the handler.
+static void
+dac_start (void)
+{
+    uint32_t f = DAC_FRAME(dac_code);
+    int i;
+
+    for (i = DAC_BYTES - 1; i >= 0; i--) {
+        dac_buf[i] = f;
+        f >>= 8;
+    }
+    dac_new = 0;
+    dac_busy = 1;
+    P2OUT &= ~DAC_CS;
+    dac_i = 1;
+    UCB0TXBUF = dac_buf[0];
+}
+
+#ifdef DAC_CONTROL
+// Send a frame and wait for it, at start up
+static void
+dac_write (uint32_t f)
+{
+    int i;
+
+    P2OUT &= ~DAC_CS;
+    for (i = (DAC_BYTES - 1) * 8; i >= 0; i -= 8) {
+        UCB0TXBUF = f >> i;
+        while (!(IFG2 & UCB0RXIFG));
+        (void) UCB0RXBUF;
+    }
+    P2OUT |= DAC_CS;
+}
+#endif
+
+//
+// SPI on USCI_B0, master, MSB first, SMCLK / 2, SCLK idle low.  DAC_PHASE
+// sets the edge the DAC takes the data on.
+//
+void
+pwm_init (unsigned int duty)
+{
+    P2DIR |= DAC_CS;            // P2.3 output - chip select
+    P2SEL &= ~DAC_CS;
+    P2OUT |= DAC_CS;
+
+    UCB0CTL1 = UCSWRST | UCSSEL_2;      // hold the USCI, clock from SMCLK
+    UCB0CTL0 = DAC_PHASE | UCMSB | UCMST | UCSYNC;     // 3-pin SPI master, MSB first
+    UCB0BR0 = 2;
+    UCB0BR1 = 0;
+    P1SEL |= BIT5 | BIT7;       // Function: UCB0CLK, UCB0SIMO
+    P1SEL2 |= BIT5 | BIT7;
+    UCB0CTL1 &= ~UCSWRST;
+
+#ifdef DAC_CONTROL
+    dac_write(DAC_CONTROL);
+#endif
+
+    // Timer 1 for the tick alone
+    TA1CCR0 = 65535;
+    TA1CTL = TASSEL_2 + MC_1;   // SMCLK, up mode - counts to TA1CCR0
+
+    dac_code = DAC_CODE(duty);
+    dac_start();
+    IE2 |= UCB0RXIE;
+}
+
+// Set the DAC from a duty cycle, without waiting for it to be sent
+void
+pwm_set (unsigned int duty)
+{
+    _BIC_SR (GIE);
+    dac_code = DAC_CODE(duty);
+    if (dac_busy)
+        dac_new = 1;
+    else
+        dac_start();
+    _BIS_SR (GIE);
+}
+
+// A byte has been sent
+ISR(USCIAB0RX_VECTOR, dac_isr)
+{
+    (void) UCB0RXBUF;           // clears UCB0RXIFG
+    if (dac_i < DAC_BYTES) {
+        UCB0TXBUF = dac_buf[dac_i++];
+        return;
+    }
+    P2OUT |= DAC_CS;            // the DAC takes the code
+    dac_busy = 0;
+    if (dac_new)
+        dac_start();
+}
+
+#endif /* SPI_DAC */
@@ -0,0 +1,51 @@
+/*
+ * flash.c - Erase and write a segment of information flash
+ *
+ * Copyright 2014-2017 Glen Overby
+ * 
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * The G2553 has four 64 byte segments of information flash: D at 0x1000,
+ * C, B, and A at 0x10c0.  A holds the DCO calibration and is locked.
+ *
+ * The CPU is held while a segment is erased, about 12 ms, so a counter
+ * overflow can be missed.  Write just after a 1PPS capture, and expect
+ * that second's count to be off.
+ */
+
+#include "gpsdo.h"
+
+// Flash timing generator: MCLK / (FLASH_FN + 1), 400 khz
+#define FLASH_FN        (CPU_MHZ * 10 / 4 - 1)
+
+//
+// Erase the segment and write len bytes (up to INFO_SIZE) of data to it
+//
+void
+flash_write (void *segment, const void *data, unsigned int len)
+{
+    volatile unsigned char *d = segment;
+    const unsigned char *s = data;
+
+    _BIC_SR(GIE);
+    FCTL2 = FWKEY | FSSEL_1 | FLASH_FN;
+    FCTL3 = FWKEY;              // unlock
+    FCTL1 = FWKEY | ERASE;
+    *d = 0;                     // a dummy write starts the erase
+    FCTL1 = FWKEY | WRT;
+    while (len--)
+        *d++ = *s++;
+    FCTL1 = FWKEY;
+    FCTL3 = FWKEY | LOCK;
+    _BIS_SR(GIE);
+}
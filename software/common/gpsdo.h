@@ -0,0 +1,347 @@
+/*
+ * gpsdo.h - Drivers shared by the GPSDO programs
+ *
+ * Copyright 2014-2017 Glen Overby
+ * 
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Pins used by the drivers:
+ *
+ * P1.0 TACLK (input) - 10mhz from the oscillator
+ * P1.1 1PPS input
+ * P1.2 Serial out
+ * P1.3 comparison input, through Comparator_A+ (COMPARE_INPUT)
+ * P1.6 1PPS output, timer 0's TA0.1 (PPS_OUT)
+ * P2.2 PWM Output from timer 1 (the coarse one, with DUAL_PWM)
+ * P2.4 Serial in (rx.c, if used), or the fine PWM output (DUAL_PWM)
+ * P2.6 XIN: 10mhz from the oscillator, for timer 1 (OSC_CLOCK)
+ *
+ * With SPI_DAC, in place of the PWM (dac.c):
+ * P1.5 UCB0CLK to the DAC
+ * P1.7 UCB0SIMO to the DAC
+ * P2.3 DAC chip select
+ */
+
+#ifndef GPSDO_H
+#define GPSDO_H
+
+#include <stdint.h>
+#ifdef __MSP430__
+#include <msp430.h>
+#elif defined(HOST_TIMER)
+#include "timer.h"              // timer 0 on the host (sim/timer.h)
+#endif
+
+/*
+ * Processor clock in Mhz, from the DCO calibration constants: 12 or 16.
+ * The Makefile sets this for each program.
+ */
+#ifndef CPU_MHZ
+#define CPU_MHZ 16
+#endif
+
+// Serial port speed, both directions.  config.c works out the divisor, and
+// stops the build if CPU_MHZ can't make BAUD to within 2%.  The receiver,
+// in software, can't go as fast as the USCI: a bit must be longer than the
+// interrupt handlers that can hold it off.
+#ifndef BAUD
+#define BAUD    9600
+#endif
+#define RX_MAX_BAUD     (CPU_MHZ * 1000000L / 256)
+
+/*
+ * Timer 1, and so the PWM, clocked by the oscillator rather than the DCO,
+ * so the PWM period doesn't drift with the DCO's temperature.  The 10mhz
+ * goes to XIN (P2.6) as well as TACLK, as an external clock for ACLK,
+ * divided in hardware by OSC_CLOCK.  (1, the 10mhz itself, is beyond the
+ * G2553's specified XIN clock, so try it on the board at hand.)  Since the
+ * VLO can't run with XIN in use, the tick and the oscillator watchdog move
+ * to the watchdog timer's interval interrupt on SMCLK (the DCO), which also
+ * does the watchdog reset in software.
+ */
+#ifndef OSC_CLOCK
+#define OSC_CLOCK       0
+#endif
+#if OSC_CLOCK
+#define TIMER1_HZ       (10000000L / OSC_CLOCK)
+#else
+#define TIMER1_HZ       (CPU_MHZ * 1000000L)
+#endif
+
+/*
+ * Dual PWM: the duty cycle is split into a coarse and a fine byte, each a
+ * PWM on timer 1 with a period of DUAL_PERIOD counts (62.5khz at 16mhz), the
+ * coarse on P2.2 and the fine on P2.4, summed by resistors ahead of the
+ * filter.  At that frequency the filter can be fast enough to settle
+ * within the second an adjustment is made in.  The fine resistor should be
+ * a little under 256 times the coarse, so the fine PWM's full scale is
+ * more than a coarse step, and DUAL_FINE_STEP is the fine counts that make
+ * up a coarse step, from the measured resistors: R fine / R coarse.  (The
+ * counter can't resolve a coarse step, 1/256 of the PWM range, quickly
+ * enough to measure it in the field.)
+ */
+#ifndef DUAL_PWM
+#define DUAL_PWM        0
+#endif
+#ifndef DUAL_FINE_STEP
+#define DUAL_FINE_STEP  200
+#endif
+#define DUAL_PERIOD     256
+#if DUAL_FINE_STEP > DUAL_PERIOD
+#error "DUAL_FINE_STEP must be at most DUAL_PERIOD: the fine PWM must span a coarse step"
+#endif
+
+/*
+ * SPI DAC: pwm_init() and pwm_set() drive a DAC_BITS (16 or 20) bit DAC on
+ * USCI_B0 in place of the PWM, and timer 1 only makes the tick.  The duty
+ * cycle is mapped to the DAC code DAC_BASE + duty << DAC_SHIFT.  For a 20
+ * bit DAC, the default DAC_SHIFT of 4 spans its range; a smaller shift with
+ * DAC_BASE at the bottom of the span that tunes the oscillator spends the
+ * duty cycle's 16 bits on a part of the range, in finer steps.
+ */
+#ifndef SPI_DAC
+#define SPI_DAC         0
+#endif
+#ifndef DAC_BITS
+#define DAC_BITS        16
+#endif
+#ifndef DAC_SHIFT
+#define DAC_SHIFT       (DAC_BITS - 16)
+#endif
+#ifndef DAC_BASE
+#define DAC_BASE        0
+#endif
+#define DAC_CODE(d)     ((uint32_t) DAC_BASE + ((uint32_t) (d) << DAC_SHIFT))
+#if SPI_DAC && (DUAL_PWM || OSC_CLOCK)
+#error "SPI_DAC replaces the PWM: it can't be used with DUAL_PWM or OSC_CLOCK"
+#endif
+#if SPI_DAC && DAC_BASE + (65535UL << DAC_SHIFT) >> DAC_BITS != 0
+#error "DAC_BASE and DAC_SHIFT map duty cycles beyond the DAC's codes"
+#endif
+
+// The tick is timer 1's period, unless that is too fast or stops with the
+// oscillator; then it is the watchdog timer's interval interrupt.
+#define WDT_TICK        (OSC_CLOCK || DUAL_PWM)
+#if WDT_TICK
+#define TICK_CLOCKS     32768   // DCO clocks a tick: the watchdog timer's interval
+#else
+#define TICK_CLOCKS     65536   // DCO clocks a tick: timer 1's period
+#endif
+
+/*
+ * Interrupt handler declaration.  The TI compiler uses a pragma, gcc uses
+ * an attribute.  On the host, a handler is a function the test calls.
+ */
+#if defined(__TI_COMPILER_VERSION__)
+#define PRAGMA(x)           _Pragma(#x)
+#define ISR(vec, name)      PRAGMA(vector=vec) __interrupt void name (void)
+#elif defined(__MSP430__)
+#define ISR(vec, name)      void __attribute__((interrupt(vec))) name (void)
+#else
+#define ISR(vec, name)      void name (void)
+#endif
+
+/*
+ * A variable the C startup code leaves alone, so it keeps its value over a
+ * reset (but not a power cycle).
+ */
+#if defined(__TI_COMPILER_VERSION__)
+#define NOINIT(type, name)  PRAGMA(NOINIT(name)) type name
+#else
+#define NOINIT(type, name)  type name __attribute__((section(".noinit")))
+#endif
+
+//
+//  Data for interrupt handlers (counter.c)
+//
+extern volatile uint16_t wraps;         // counter overflows (65536 counts)
+extern volatile uint16_t ppswraps;      // wraps at the last 1pps capture
+extern volatile long capture;   // captured count
+extern volatile char pps;       // 1pps captures, for p/main.c's no 10mhz clock check
+
+// Counter overflows since the last 1pps capture: 10mhz / 65536 = 152.6 per second
+#define ppswrapped()    ((uint16_t) (wraps - ppswraps))
+
+//
+// Watchdogs for the 1PPS and oscillator signals (counter.c).  'lost' has a
+// bit set while the signal is missing: LOST_PPS from a timer 0 compare
+// PPS_HOLDOFF seconds of oscillator counts after the last 1PPS edge, until
+// the next edge, and LOST_OSC when timer 0 hasn't counted for OSC_HOLDOFF
+// milliseconds of the DCO (timer 1's period), until it counts again.
+//
+#ifndef PPS_HOLDOFF
+#define PPS_HOLDOFF     15      // seconds
+#endif
+/*
+ * 1PPS validation (PPS_VALIDATE): both edges of the 1PPS are captured, and
+ * a second is only taken from a falling edge once the rising edge has come
+ * within PPS_MIN_WIDTH to PPS_MAX_WIDTH of it, and at least half a second
+ * after the last second taken.  (A pulse of the wrong polarity is about a
+ * second less its width long.)  The pulses turned away are counted by
+ * class in ppsstats.
+ */
+#ifndef PPS_VALIDATE
+#define PPS_VALIDATE    0
+#endif
+#ifndef PPS_MIN_WIDTH
+#define PPS_MIN_WIDTH   1       // microseconds
+#endif
+#ifndef PPS_MAX_WIDTH
+#define PPS_MAX_WIDTH   500     // milliseconds
+#endif
+#define PPS_MIN_PERIOD  (5000000UL >> 16)       // wraps: half a second
+#ifndef OSC_HOLDOFF
+#define OSC_HOLDOFF     100     // milliseconds
+#endif
+#define LOST_PPS        0x01
+#define LOST_OSC        0x02
+
+extern volatile char lost;
+
+#if PPS_VALIDATE
+struct ppsstats {
+    unsigned int good;          // seconds taken
+    unsigned int narrow;        // pulses under PPS_MIN_WIDTH
+    unsigned int wide;          // pulses over PPS_MAX_WIDTH
+    unsigned int twice;         // good pulses within half a second of the last
+};
+extern volatile struct ppsstats ppsstats;
+
+void pps_report (void);
+#endif
+
+/*
+ * 1PPS output (PPS_OUT): timer 0's compare register 1 drives TA0.1 (P1.6)
+ * high every 10,000,000 oscillator counts, for PPS_OUT_WIDTH counter wraps
+ * (105ms).  The edges are made by the timer, so they are as exact as the
+ * oscillator.  Each second, the offset of the output's rising edge from
+ * the GPS 1PPS is taken, in oscillator counts (positive when the output is
+ * late), and the next second is shortened by a part of it, so the output
+ * slews towards the GPS 1PPS at up to PPS_OUT_SLEW counts a second.  The
+ * first offset is stepped out at once.  Until the oscillator is on
+ * frequency, the output trails the GPS 1PPS by 2^PPS_OUT_SHIFT times its
+ * error in counts a second.  Without the GPS 1PPS, the output carries on
+ * from the oscillator alone.
+ */
+#ifndef PPS_OUT
+#define PPS_OUT         0
+#endif
+#define PPS_OUT_WIDTH   16      // wraps the output is high
+#define PPS_OUT_SHIFT   2       // a second's correction is the offset >> PPS_OUT_SHIFT
+#ifndef PPS_OUT_SLEW
+#define PPS_OUT_SLEW    100     // counts a second, at most
+#endif
+
+/*
+ * Comparison input (COMPARE_INPUT): a second 1PPS, or another oscillator
+ * divided to 1 Hz, on P1.3, timestamped by timer 0's capture register 1
+ * against the same oscillator counts as the GPS 1PPS.  CCI1A is P1.2, the
+ * serial output, so the input goes through Comparator_A+ (CA3 against half
+ * of Vcc, its output filter on) to CCI1B.  cmp_report() gives the rising
+ * edge's offset from the last GPS 1PPS, in oscillator counts, positive when
+ * the input is later.
+ */
+#ifndef COMPARE_INPUT
+#define COMPARE_INPUT   0
+#endif
+#if COMPARE_INPUT && PPS_OUT
+#error "COMPARE_INPUT and PPS_OUT both use timer 0's register 1"
+#endif
+
+#if COMPARE_INPUT
+void cmp_report (void);
+#endif
+
+#if PPS_OUT
+extern volatile long ppsout;    // offset of the last output edge from the GPS 1PPS
+extern volatile char ppsout_steered;    // the GPS 1PPS was there for it
+
+void ppsout_report (void);
+#endif
+
+// Ticks of TICK_CLOCKS DCO clocks (timer 1 periods, 4.1ms at 16mhz, or
+// watchdog timer intervals with WDT_TICK), for work that isn't timed by the
+// oscillator
+extern volatile uint16_t ticks;
+#define TICKS_MS(ms)    ((ms) * CPU_MHZ * 1000UL / TICK_CLOCKS)
+
+#ifdef ISR_STATS
+//
+// Capture interrupt statistics: latency from the 1PPS edge to the handler
+// (TA0R at entry - TA0CCR0) in oscillator counts, and collisions.
+//
+#define ISR_HIST        8       // latency histogram buckets
+#define ISR_HIST_SHIFT  3       //   each 8 counts wide, the last is open ended
+
+struct isrstats {
+    unsigned int lat_min;
+    unsigned int lat_max;
+    unsigned int lat_hist[ISR_HIST];
+    unsigned int cov;           // capture overflow: 1PPS edges too close together
+    unsigned int wrap;          // counter overflow pending at capture
+};
+extern volatile struct isrstats isrstats;
+
+void isr_report (void);
+#endif
+
+//
+// Basic Output (serial.c, tx() is in config.c)
+//
+void tx (char c);
+void printfx4 (int v);
+void printfx16 (int v);
+void printfx32 (long v);
+void printfd (int v);
+void printfld (long v);
+void printfs (const char *c);
+void nl (void);
+
+//
+// Basic Input (rx.c): characters received on P2.4 by timer 1
+//
+void rx_init (void);
+int rx (void);
+
+//
+// Configuration (config.c)
+//
+void clock_init (void);
+void counter_init (void);
+void pwm_init (unsigned int duty);      // dac.c with SPI_DAC
+void pwm_set (unsigned int duty);       //   likewise
+void uart_init (void);
+void watchdog_init (void);
+
+// Clear the watchdog; it resets the processor if not cleared for about 2.7
+// seconds (32768 VLO clocks, 1.6 to 8 seconds over the VLO's range, or
+// WATCHDOG_TICKS with WDT_TICK).
+#if WDT_TICK
+#define WATCHDOG_TICKS      TICKS_MS(2700)
+extern volatile uint16_t watchdog_ticks;
+#define watchdog_clear()    (watchdog_ticks = 0)
+#else
+#define watchdog_clear()    (WDTCTL = WDT_ARST_1000)
+#endif
+
+//
+// Information flash (flash.c)
+//
+#define INFO_D          ((void *) 0x1000)
+#define INFO_C          ((void *) 0x1040)
+#define INFO_B          ((void *) 0x1080)
+#define INFO_SIZE       64
+
+void flash_write (void *segment, const void *data, unsigned int len);
+
+#endif /* GPSDO_H */
@@ -0,0 +1,101 @@
+/*
+ * rx.c - Basic Input: a timer driven serial receiver
+ *
+ * Copyright 2014-2017 Glen Overby
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * The USCI's receive pin, P1.1, is the 1PPS capture input, so characters
+ * are received on P2.4 by timer 1's capture/compare register 2 (TA1.2,
+ * CCI2A).  It captures the falling edge of the start bit, then switches to
+ * compare to latch the input (SCCI) in the middle of each data bit, and
+ * back to capture after the 8th.  Timer 1 counts the DCO, as the USCI's
+ * transmitter does (or the oscillator, with OSC_CLOCK), and its period is
+ * 65536 counts, so the compare arithmetic wraps with it.
+ *
+ * The handler puts each character in a ring buffer that rx() takes them
+ * from.  Characters received while it is full are dropped.
+ */
+
+#include "gpsdo.h"
+
+// Left out when BAUD is too fast for it, or DUAL_PWM has P2.4 and CCR2; a
+// program that uses it checks
+#if BAUD <= RX_MAX_BAUD && !DUAL_PWM
+
+#define RX_BIT          (TIMER1_HZ / BAUD)      // timer 1 counts a bit
+#define RX_SIZE         16      // ring buffer, a power of 2
+
+static volatile char rxbuf[RX_SIZE];
+static volatile unsigned char rxhead = 0;       // next slot the handler fills
+static volatile unsigned char rxtail = 0;       // next slot rx() takes
+static unsigned char rxbits;    // data bits received of this character
+static unsigned char rxchar;    //   and their values, the first bit lowest
+
+//
+// Receive on P2.4
+//
+void
+rx_init (void)
+{
+    P2DIR &= ~BIT4;             // input
+    P2SEL |= BIT4;              // Function: TA1.2 CCI2A
+    TA1CCTL2 = CM_2 | CCIS_0 | SCS | CAP | CCIE;       // capture the start bit, falling edge
+}
+
+// The next character received, or -1 if there is none
+int
+rx (void)
+{
+    int c;
+
+    if (rxtail == rxhead)
+        return -1;
+    c = (unsigned char) rxbuf[rxtail];
+    rxtail = (rxtail + 1) & (RX_SIZE - 1);
+    return c;
+}
+
+// Timer 1 capture/compare 1, 2 and overflow.  Only 2 is enabled.
+ISR(TIMER1_A1_VECTOR, Timer1_A1)
+{
+    unsigned char next;
+
+    switch (TA1IV) {
+    case 4:                     // CCR2
+        if (TA1CCTL2 & CAP) {
+            // start bit: compare in the middle of the first data bit
+            TA1CCR2 += RX_BIT + RX_BIT / 2;
+            TA1CCTL2 &= ~CAP;
+            rxbits = 0;
+            break;
+        }
+        rxchar >>= 1;
+        if (TA1CCTL2 & SCCI)
+            rxchar |= 0x80;
+        if (++rxbits < 8) {
+            TA1CCR2 += RX_BIT;
+            break;
+        }
+        // the last data bit: wait for the next start bit
+        TA1CCTL2 |= CAP;
+        next = (rxhead + 1) & (RX_SIZE - 1);
+        if (next != rxtail) {
+            rxbuf[rxhead] = rxchar;
+            rxhead = next;
+        }
+        break;
+    }
+}
+
+#endif /* BAUD <= RX_MAX_BAUD && !DUAL_PWM */
@@ -0,0 +1,101 @@
+/*
+ * serial.c - Basic Output: character, string, decimal, hex (4, 16, and 32 bits)
+ *
+ * Copyright 2014-2017 Glen Overby
+ * 
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * printf for basic format types.  Calls to printf are expensive, these are
+ * shortcuts.  None of these use sprintf, which by itself is a large part of
+ * the G2xx flash.
+ *
+ * Characters are sent with tx() (config.c), so this file is also used by the
+ * host simulator.
+ */
+
+#include "gpsdo.h"
+
+// printf(%x) of 1 digit.
+void
+printfx4 (int v)
+{
+    v &= 0xf;
+    v += '0';
+    if (v > '9')
+        v += 7;
+    tx ((char) v);
+}
+
+// printf(%x) of 16-bit word.
+void
+printfx16 (int v)
+{
+    printfx4 (v >> 12);
+    printfx4 (v >> 8);
+    printfx4 (v >> 4);
+    printfx4 (v);
+}
+
+// printf(%x) of 32-bit word.
+void
+printfx32 (long v)
+{
+    printfx16 (v >> 16);
+    printfx16 (v);
+}
+
+// printf(%ld)
+void
+printfld (long v)
+{
+    char output[11];            // 10 digits and the terminator
+    char *c = output + sizeof(output);
+    unsigned long u = v;
+
+    if (v < 0) {
+        tx ('-');
+        u = -u;
+    }
+    *--c = '\0';
+    do {
+        *--c = '0' + u % 10;
+        u /= 10;
+    } while (u);
+    printfs (c);
+}
+
+// printf(%d)
+void
+printfd (int v)
+{
+    printfld (v);
+}
+
+// printf(%s)
+void
+printfs (const char *c)
+{
+    for (; *c; c++) {
+        if (*c == '\n')
+            tx ('\r');
+        tx (*c);
+    }
+}
+
+// newline (CR & LF)
+void
+nl (void)
+{
+    tx ('\r');
+    tx ('\n');
+}
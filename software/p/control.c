@@ -0,0 +1,123 @@
+/*
+ * control.c - Proportional Control
+ *
+ * Copyright 2014-2017 Glen Overby
+ * 
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Like pid2's, the controller only reaches the hardware through pwm_set(),
+ * so it can be run on the host by the replay harness.  The LEDs are left
+ * to main.c, which follows 'blink'.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include "gpsdo.h"
+#include "p.h"
+
+char blink = 2;
+
+static uint16_t pwm_duty_cycle;         // PWM duty cycle ~ voltage
+static int32_t sum;             // sum of captured counts during (counter) pulses
+static int16_t counter;         // count of 1pps pulses before acting.
+
+void
+p_init (uint16_t duty)
+{
+    pwm_duty_cycle = duty;
+    sum = 0;
+    counter = -10;
+    blink = 2;
+    pwm_set(pwm_duty_cycle);
+}
+
+//
+// c is the count of oscillator clocks captured for the last second.
+// Returns 1 when a 10 second sample ended and the duty cycle was set.
+//
+int
+p_pps (int32_t c)
+{
+    int32_t error;              // calculated error from 10mhz
+    int16_t adjust;             // adjustment of PWM duty cycle
+
+    if (counter >= 0) {
+        sum += c;
+    }
+#ifdef REPORT_C
+    tx('c');
+    printfx32(c);
+    tx(' ');
+    printfx32(sum);
+    //nl();
+    tx('\r');
+#endif
+
+    counter++;
+    if (counter != 10)
+        return 0;
+
+    tx('*');
+    printfx32(sum);
+    tx(' ');
+
+    error = 100000000 - sum;
+    printfd(error);
+
+    if (labs(error) >= 10) {
+        blink = 2;
+    } else if (labs(error) < 2) {
+        // should make the requirement for this state be that error < 2 for at least 5 samples.
+        blink = 0;
+    } else {
+        blink = 1;
+    }
+
+    //adjust = error * 7;       // approximately 2.2 PWM steps per hertz for FOX801 10mhz oscillator
+    if (labs(error) > 2) {                      // Error > 5 for FOX801
+        //adjust = error * 25;          // Error adjustment for FOX801 10mhz oscillator.
+        adjust = error * 75;            // Error adjustment for Isotemp 134-10 10mhz oscillator.
+        if (adjust > 10000) {
+            adjust = 10000;
+        } else if (adjust < -10000) {
+            adjust = -10000;
+        }
+    } else if (labs(error) > 1) {
+        //adjust = error * 3;           // Error adjustment for FOX801 10mhz oscillator.
+        adjust = error * 10;            // Error adjustment for Isotemp 134-10 10mhz oscillator
+    } else {
+        adjust = error;
+    }
+    if (adjust > 0 && (uint16_t) (pwm_duty_cycle + adjust) < pwm_duty_cycle) {
+        // Overflow
+        pwm_duty_cycle = 0xffff;
+    } else if (adjust < 0 && (uint16_t) (pwm_duty_cycle + adjust) > pwm_duty_cycle) {
+        pwm_duty_cycle = 1;
+    } else {
+        pwm_duty_cycle += adjust;
+    }
+    tx(' ');
+    printfx16(pwm_duty_cycle);
+    tx(' ');
+    printfd(adjust);
+    tx(' ');tx(' ');tx(' ');tx(' ');
+    nl();
+    pwm_set(pwm_duty_cycle);
+
+    counter = -5;
+    sum = 0;
+    return 1;
+}
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
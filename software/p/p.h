@@ -0,0 +1,36 @@
+/*
+ * p.h - Proportional Control
+ *
+ * Copyright 2014-2017 Glen Overby
+ * 
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef P_H
+#define P_H
+
+#define REPORT_C
+
+#define P_START         32768   // PWM duty cycle at power on
+
+#include <stdint.h>
+
+extern char blink;              // blink LED on 1pps.
+                                // 1 = toggle green LED  2 = toggle red LED
+
+// Controller (control.c)
+void p_init (uint16_t duty);
+int p_pps (int32_t c);
+
+#endif /* P_H */
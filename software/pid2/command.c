@@ -0,0 +1,293 @@
+/*
+ * command.c - Command interface on the serial input
+ *
+ * Copyright 2014-2017 Glen Overby
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Built with -DCOMMANDS=1.  A line of up to COMMAND_LINE characters,
+ * ended by CR or LF, is one of:
+ *
+ *  get [name]          show a setting, or all of them
+ *  set name value      change a setting, from the next sample on
+ *  state n             force the state machine to START (0), FASTINIT (7)
+ *                      or SLOWINIT (10)
+ *  stats               show the state, duty cycle, integral history,
+ *                      outliers and lost signals (and report and reset the
+ *                      interrupt statistics and 1PPS validation counts,
+ *                      the 1PPS output's offset and the 1PPS jitter)
+ *  save                keep the settings in information flash, where they
+ *                      are loaded from at power on
+ *
+ * The settings are the fields of struct tune (pid2.h).  p_fast,
+ * fast_seconds and max_error are also checked against each other, so
+ * FAST's adjustment can't overflow.  Replies start with "# ", so they are
+ * told from the controller's status lines.
+ */
+
+#include <string.h>
+#include "gpsdo.h"
+#include "pid2.h"
+
+#if COMMANDS
+
+#if BAUD > RX_MAX_BAUD
+#error "BAUD is too fast for the serial input (rx.c)"
+#endif
+#if DUAL_PWM
+#error "DUAL_PWM uses the serial input's pin and timer register"
+#endif
+
+static const struct setting {
+    const char *name;
+    int16_t *v;
+    int16_t min, max;
+} settings[] = {
+    { "p_fast",         &tune.p_fast,           1,  32767 },
+    { "max_error",      &tune.max_error,        1,  32767 },
+    { "p_slow",         &tune.p_slow,           0,  32767 },
+    { "i_slow",         &tune.i_slow,           0,  32767 },
+    { "settle",         &tune.settle,           0,  60 },
+    { "p_band",         &tune.p_band,           0,  128 },
+    { "i_band",         &tune.i_band,           0,  32767 },
+    { "fast_seconds",   &tune.fast_seconds,     1,  200 },     // the sum of counts
+    { "slow_seconds",   &tune.slow_seconds,     1,  200 },     //   fits in 32 bits
+#if PLL
+    { "pll_tau",        &tune.pll_tau,          60, 10000 },
+    { "pll_damping",    &tune.pll_damping,      10, 400 },
+#endif
+    { NULL }
+};
+
+static char line[COMMAND_LINE + 1];     // line being received
+static unsigned char len;       // characters in line
+static char toolong;            // characters were dropped from line
+static char saving;             // save when the next 1PPS has been captured
+
+// The next word of *p, ended by a space or the end of the line
+static char *
+word (char **p)
+{
+    char *s = *p;
+    char *w;
+
+    while (*s == ' ')
+        s++;
+    w = s;
+    while (*s && *s != ' ')
+        s++;
+    if (*s)
+        *s++ = '\0';
+    *p = s;
+    return w;
+}
+
+// Decimal number in s.  Returns 0 if s isn't one that fits in 16 bits.
+static int
+number (const char *s, int16_t *v)
+{
+    int32_t n = 0;
+    char neg = 0;
+
+    if (*s == '-') {
+        neg = 1;
+        s++;
+    }
+    if (*s == '\0')
+        return 0;
+    for (; *s; s++) {
+        if (*s < '0' || *s > '9' || n > 32767)
+            return 0;
+        n = n * 10 + *s - '0';
+    }
+    if (n > 32767)
+        return 0;
+    *v = neg ? -n : n;
+    return 1;
+}
+
+static const struct setting *
+setting (const char *name)
+{
+    const struct setting *s;
+
+    for (s = settings; s->name; s++)
+        if (strcmp(s->name, name) == 0)
+            return s;
+    return NULL;
+}
+
+static void
+show (const struct setting *s)
+{
+    printfs("# ");
+    printfs(s->name);
+    tx(' ');
+    printfd(*s->v);
+    nl();
+}
+
+//
+// FAST's adjustment, (p_fast / fast_seconds) * error with the error kept
+// within max_error, must fit in 16 bits, and its gain must be 1 to 32000,
+// so p_fast can't be less than fast_seconds.  A new p_fast or fast_seconds
+// brings max_error down to fit (as auto-tuning sets it), and a new
+// max_error must fit.  Returns 0 if v can't be set.
+//
+static int
+fast_check (const struct setting *s, int16_t v)
+{
+    int16_t p = tune.p_fast;
+    int16_t n = tune.fast_seconds;
+    int16_t m;
+
+    if (s->v == &tune.p_fast)
+        p = v;
+    else if (s->v == &tune.fast_seconds)
+        n = v;
+    else if (s->v != &tune.max_error)
+        return 1;
+    if (p < n || p / n > 32000)
+        return 0;
+    m = 32000 / (p / n);
+    if (s->v == &tune.max_error)
+        return v <= m;
+    if (tune.max_error > m) {
+        tune.max_error = m;
+        show(setting("max_error"));
+    }
+    return 1;
+}
+
+static void
+reply (const char *m)
+{
+    printfs("# ");
+    printfs(m);
+    nl();
+}
+
+static void
+stats (void)
+{
+    struct resume r;
+
+    control_save(&r);
+    printfs("# state ");
+    printfd(r.state);
+    printfs(" duty ");
+    printfx16(r.duty);
+    printfs(" Ihist ");
+    printfd(r.Ihist);
+#if CAPTURE_FILTER
+    printfs(" outliers ");
+    printfd(outliers);
+#endif
+    printfs(" lost ");
+    printfd(lost);
+    nl();
+#ifdef ISR_STATS
+    isr_report();
+#endif
+#if PPS_OUT
+    ppsout_report();
+#endif
+#if PPS_VALIDATE
+    pps_report();
+#endif
+#if AUTO_BANDWIDTH
+    jitter_report();
+#endif
+}
+
+static void
+command (char *p)
+{
+    const struct setting *s;
+    char *cmd = word(&p);
+    char *name = word(&p);
+    char *value = word(&p);
+    int16_t v;
+
+    if (*word(&p)) {
+        reply("too many words");
+    } else if (strcmp(cmd, "get") == 0) {
+        if (*name == '\0') {
+            for (s = settings; s->name; s++)
+                show(s);
+        } else if ((s = setting(name)) != NULL) {
+            show(s);
+        } else {
+            reply("no such setting");
+        }
+    } else if (strcmp(cmd, "set") == 0) {
+        if ((s = setting(name)) == NULL)
+            reply("no such setting");
+        else if (!number(value, &v) || v < s->min || v > s->max
+                 || !fast_check(s, v))
+            reply("bad value");
+        else {
+            *s->v = v;
+            show(s);
+        }
+    } else if (strcmp(cmd, "state") == 0 && *value == '\0') {
+        if (!number(name, &v) || v < START || v > TUNE || !control_force(v))
+            reply("can't force that state");
+    } else if (strcmp(cmd, "stats") == 0 && *name == '\0') {
+        stats();
+    } else if (strcmp(cmd, "save") == 0 && *name == '\0') {
+        saving = 1;
+    } else {
+        reply("? get [name], set name value, state n, stats, save");
+    }
+}
+
+//
+// Take the characters received, and run a command at the end of each
+// line.  Called from the main loop, before it looks for a 1PPS capture.
+//
+void
+command_poll (void)
+{
+    int c;
+
+    // flash_write() holds the CPU long enough to miss a counter overflow,
+    // so the save waits for the start of a second (or for a lost 1PPS)
+    if (saving && (capture != 0 || (lost & LOST_PPS))) {
+        saving = 0;
+        tune_save(&tune);
+        reply("saved");
+    }
+
+    while ((c = rx()) >= 0) {
+        if (c == '\r' || c == '\n') {
+            line[len] = '\0';
+            if (toolong)
+                reply("line too long");
+            else if (len > 0)
+                command(line);
+            len = 0;
+            toolong = 0;
+        } else if (c == '\b' || c == 0x7f) {
+            if (len > 0)
+                len--;
+        } else if (len < COMMAND_LINE) {
+            line[len++] = c;
+        } else {
+            toolong = 1;
+        }
+    }
+}
+
+#endif /* COMMANDS */
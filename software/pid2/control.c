@@ -0,0 +1,1107 @@
+/*
+ * control.c - Proportional + Integral control state machine
+ *
+ * Copyright 2014-2017 Glen Overby
+ * 
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * The state machine does not touch the hardware directly: the oscillator is
+ * adjusted with pwm_set(), status is shown with ledstate(), and the error
+ * inputs are read through osc_cold() and gps_nolock().
+ *
+ * It is also compiled into the host simulator, so variables whose overflow
+ * matters are declared with the MSP430's sizes (int16_t is int, int32_t is
+ * long).
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include "gpsdo.h"
+#include "pid2.h"
+
+//  initialized to a value not used by the state check
+char state = 0;                 // state machine
+static char oldstate = 0;       //   previous state, for reporting changes
+
+static uint16_t pwm_duty_cycle;         // PWM duty cycle ~ voltage
+static int32_t sum = 0;         // sum of captured counts during (counter) pulses
+static int16_t counter = -10;   // count of 1pps pulses before acting.
+static char lockcount = 0;      // iterations that had lock.
+static int16_t Ihist;           // I history
+static char slowlock = 0;       // number of minutes with no adjustment
+static char clear = 0;          // 1PPS seconds the error has been gone, in an error state
+
+#if CAPTURE_FILTER
+//
+// Outlier filter for the per-second counts.  Counts are kept as the offset
+// from 10,000,000, clamped to +-FILTER_CLAMP.
+//
+static int16_t fhist[FILTER_SIZE];      // last FILTER_SIZE offsets
+static unsigned char fn = 0;    // offsets in fhist
+static unsigned char fi = 0;    // next slot in fhist
+uint16_t outliers = 0;          // seconds replaced by the filter
+#endif
+
+#if FAST_LSQ
+//
+// Least squares sums over FAST's window.  The phase x[k] is the sum of the
+// offsets from 10mhz of seconds 1 to k, and x[0] is 0.
+//
+static int32_t lsphase;         // x[k] of the last second
+static int32_t lsx;             // sum of x[k]
+static int32_t lskx;            // sum of k * x[k]
+#endif
+
+#if PLL
+static char pll;                // SLOW is phase locked
+static int32_t phase;           // oscillator counts ahead of the GPS 1PPS
+static int32_t pllsum;          // the loop's integral, duty cycle << PLL_FRAC
+static int32_t pllrem;          // integral still to add to pllsum, times tau
+static uint16_t pllduty;        // duty cycle at the last status message
+#endif
+
+#if AUTO_BANDWIDTH
+static int32_t jlast;           // last SLOW second's count
+static char jhave;              // jlast holds a count
+static int32_t jvar;            // mean square count change, << JITTER_FRAC
+static char bw;                 // SLOW's window, in SLOW_SECONDS
+// bw as used, held so the window's sum of counts fits in 32 bits even
+// when slow_seconds is set after bw was sized
+#define SLOW_BW         (bw > 200 / SLOW_SECONDS ? 200 / SLOW_SECONDS : bw)
+#else
+#define SLOW_BW         1
+#endif
+
+#if TUNABLE
+struct tune tune;               // gains in use
+static char tuned;              // tune holds measured (or stored) gains
+#endif
+#if AUTOTUNE
+static char ttries;             // identifications that failed
+static char tstep;              // 0: above the locked duty cycle, 1: below
+static char tsec;               // seconds counted at this step
+static int16_t tbuf[TUNE_SECONDS];      // offsets from 10mhz at this step
+static uint16_t tlock;          // locked duty cycle
+static int32_t tsum;            // count of the last SAMPLE_SECONDS above
+static int16_t tsettle;         // seconds to settle above
+#endif
+#if TUNABLE
+#define FAST_FACTOR     tune.p_fast
+#define FAST_MAX_ERROR  tune.max_error
+#define SLOW_P_FACTOR   tune.p_slow
+#define SLOW_I_FACTOR   tune.i_slow
+#define FAST_SETTLE     tune.settle
+#define SLOW_P_BAND     tune.p_band
+#define SLOW_I_BAND     tune.i_band
+#define FAST_SECONDS    tune.fast_seconds
+#define SLOW_SECONDS    tune.slow_seconds
+#define LOOP_TAU        tune.pll_tau
+#define LOOP_DAMPING    tune.pll_damping
+#else
+#define FAST_FACTOR     P_FACTOR_FAST
+#define FAST_MAX_ERROR  P_MAX_ERROR
+#define SLOW_P_FACTOR   P_FACTOR_SLOW
+#define SLOW_I_FACTOR   I_FACTOR_SLOW
+#define FAST_SETTLE     PWM_SETTLE
+#define SLOW_P_BAND     P_ERRORBAND_SLOW
+#define SLOW_I_BAND     I_ERRORBAND_SLOW
+#define FAST_SECONDS    SAMPLE_SECONDS
+#define SLOW_SECONDS    SAMPLE_MINUTE
+#define LOOP_TAU        PLL_TAU
+#define LOOP_DAMPING    PLL_DAMPING
+#endif
+
+//
+// Start the state machine over with the oscillator at the given duty cycle.
+//
+void
+control_init (uint16_t duty)
+{
+    state = oldstate = START;
+    pwm_duty_cycle = duty;
+    sum = 0;
+    lockcount = 0;
+    Ihist = 0;
+    slowlock = 0;
+    clear = 0;
+#if PLL
+    pll = 0;
+#endif
+#if AUTO_BANDWIDTH
+    jhave = 0;
+    jvar = 0;
+    bw = 1;
+#endif
+#if CAPTURE_FILTER
+    fn = fi = 0;
+    outliers = 0;
+#endif
+#if TUNABLE
+    tuned = tune_load(&tune);
+    if (!tuned) {
+        tune.p_fast = P_FACTOR_FAST;
+        tune.max_error = P_MAX_ERROR;
+        tune.p_slow = P_FACTOR_SLOW;
+        tune.i_slow = I_FACTOR_SLOW;
+        tune.settle = PWM_SETTLE;
+        tune.p_band = P_ERRORBAND_SLOW;
+        tune.i_band = I_ERRORBAND_SLOW;
+        tune.fast_seconds = SAMPLE_SECONDS;
+        tune.slow_seconds = SAMPLE_MINUTE;
+#if PLL
+        tune.pll_tau = PLL_TAU;
+        tune.pll_damping = PLL_DAMPING;
+#endif
+    }
+#endif
+#if AUTOTUNE
+    ttries = 0;
+#endif
+    pwm_set(pwm_duty_cycle);
+    ledstate(0,0,0);
+    counter = -1;
+}
+
+//
+// Save the state that control_resume() needs to carry on after a watchdog
+// reset.
+//
+void
+control_save (struct resume *r)
+{
+    r->duty = pwm_duty_cycle;
+    r->Ihist = Ihist;
+    r->state = state;
+}
+
+//
+// Start again after a watchdog reset, from control_save()'s state.  SLOW
+// carries on with its integral history, skipping the partial second the
+// counter restarted in and the one after, as SLOWINIT does.  FAST starts
+// over from the saved duty cycle rather than PWM_START, and any other state
+// is checked again from START.
+//
+void
+control_resume (const struct resume *r)
+{
+    control_init(r->duty);
+    switch (r->state) {
+    case SLOWINIT:
+    case SLOW:
+        state = oldstate = SLOW;
+        Ihist = r->Ihist;
+        counter = -2;
+        ledstate(0, 1, 0);
+        break;
+    case FASTINIT:
+    case FASTWAIT:
+    case FAST:
+    case TUNE:
+        state = FASTINIT;
+        break;
+    }
+}
+
+//
+// Force the state machine into a state, from the command interface.  Only
+// the states that start a phase over can be forced: START (check for
+// errors again), FASTINIT and SLOWINIT.  Returns 0 for any other.
+//
+int
+control_force (char s)
+{
+    switch (s) {
+    case START:
+    case FASTINIT:
+    case SLOWINIT:
+        state = s;
+        return 1;
+    }
+    return 0;
+}
+
+#if CAPTURE_FILTER
+// median of n values
+static int16_t
+median (const int16_t *v, int n)
+{
+    int16_t s[FILTER_SIZE];
+    int16_t x;
+    int i, j;
+
+    // insertion sort
+    for (i = 0; i < n; i++) {
+        x = v[i];
+        for (j = i; j > 0 && s[j - 1] > x; j--)
+            s[j] = s[j - 1];
+        s[j] = x;
+    }
+    return s[n / 2];
+}
+
+//
+// Hampel filter.  A second whose count is further from the median of the
+// last FILTER_SIZE seconds than FILTER_MADS times the median absolute
+// deviation (or FILTER_MIN counts, whichever is larger) is an outlier: a
+// missed or doubled 1PPS edge, or a capture that raced the counter overflow.
+// The median is used in its place.
+//
+// Each count goes into the history whether or not it is an outlier, so a
+// real change in frequency is accepted once it makes up half of the history.
+// The history is started over after the large adjustments made in FAST; the
+// SLOW adjustments are too small to matter.
+//
+static int32_t
+capture_filter (int32_t c)
+{
+    int32_t d = c - 10000000;
+    int16_t x, med, lim;
+    int16_t dev[FILTER_SIZE];
+    int i;
+
+    if (d > FILTER_CLAMP)
+        x = FILTER_CLAMP;
+    else if (d < -FILTER_CLAMP)
+        x = -FILTER_CLAMP;
+    else
+        x = d;
+
+    if (fn >= 3) {
+        med = median(fhist, fn);
+        for (i = 0; i < fn; i++)
+            dev[i] = abs(fhist[i] - med);
+        lim = median(dev, fn) * FILTER_MADS;
+        if (lim < FILTER_MIN)
+            lim = FILTER_MIN;
+        if (abs(x - med) > lim) {
+            outliers++;
+            printfs("** outlier ");
+            printfld(d);
+            tx(' ');
+            printfd(outliers);
+            nl();
+            c = 10000000 + med;
+        }
+    }
+
+    fhist[fi] = x;
+    if (++fi >= FILTER_SIZE)
+        fi = 0;
+    if (fn < FILTER_SIZE)
+        fn++;
+    return c;
+}
+#endif
+
+#if AUTOTUNE
+// Duty cycle for an identification step, kept in range
+static uint16_t
+tune_duty (char step)
+{
+    if (step == 0)
+        return tlock > 0xffff - TUNE_STEP ? 0xffff : tlock + TUNE_STEP;
+    return tlock <= TUNE_STEP ? 1 : tlock - TUNE_STEP;
+}
+
+static void
+tune_set (char step)
+{
+    tstep = step;
+    tsec = 0;
+    pwm_set(step < 2 ? tune_duty(step) : tlock);
+}
+
+//
+// One second of identification.  x is the offset from 10mhz.  At the end
+// of each step, the count of the last SAMPLE_SECONDS is kept and the
+// seconds it took to settle within TUNE_BAND of it.  Returns 1 when done.
+//
+static int
+tune_second (int16_t x)
+{
+    int32_t s = 0, pf;
+    int16_t settle;
+    int i;
+
+    tbuf[(int) tsec++] = x;
+    if (tsec < TUNE_SECONDS)
+        return 0;
+
+    for (i = TUNE_SECONDS - SAMPLE_SECONDS; i < TUNE_SECONDS; i++)
+        s += tbuf[i];
+    for (i = TUNE_SECONDS - 1; i >= 0; i--)
+        if (labs((int32_t) tbuf[i] * SAMPLE_SECONDS - s) > TUNE_BAND * SAMPLE_SECONDS)
+            break;
+    settle = i + 1;
+
+    printfs("** tune ");
+    printfd(tstep);
+    tx(' ');
+    printfld(s);
+    tx(' ');
+    printfd(settle);
+    nl();
+
+    if (tstep == 0) {
+        tsum = s;
+        tsettle = settle;
+        tune_set(1);
+        return 0;
+    }
+
+    // Steps per Hz: the duty cycle span over the change in the count of
+    // SAMPLE_SECONDS.  Not settled before the counting began is a failure,
+    // as is a result that won't fit the FAST arithmetic.
+    tune_set(2);
+    tuned = 1;
+    pf = 0;
+    if (tsum > s && settle <= TUNE_SECONDS - SAMPLE_SECONDS
+        && tsettle <= TUNE_SECONDS - SAMPLE_SECONDS)
+        pf = (int32_t) (tune_duty(0) - tune_duty(1)) * SAMPLE_SECONDS / (tsum - s);
+    if (pf < SAMPLE_SECONDS || pf > 32767) {
+        printfs("** tune failed");
+        nl();
+        if (++ttries < TUNE_TRIES)
+            tuned = 0;          // try again the next time FAST locks
+        return 1;
+    }
+    tune.p_fast = pf;
+    tune.max_error = 32000 / (tune.p_fast / SAMPLE_SECONDS);
+    tune.p_slow = tune.p_fast / TUNE_P_SLOW_DIV;
+    if (tune.p_slow < 1)
+        tune.p_slow = 1;
+    tune.i_slow = tune.p_fast / TUNE_I_SLOW_DIV;
+    if (tune.i_slow < 1)
+        tune.i_slow = 1;
+    tune.settle = settle > tsettle ? settle : tsettle;
+    if (tune.settle < PWM_SETTLE)
+        tune.settle = PWM_SETTLE;
+    tune_save(&tune);
+
+    printfs("** tuned ");
+    printfd(tune.p_fast);
+    tx(' ');
+    printfd(tune.max_error);
+    tx(' ');
+    printfd(tune.p_slow);
+    tx(' ');
+    printfd(tune.i_slow);
+    tx(' ');
+    printfd(tune.settle);
+    nl();
+    return 1;
+}
+#endif
+
+#if FAST_LSQ
+// Second k of the window, offset y from 10mhz
+static void
+lsq_add (int16_t k, int32_t y)
+{
+    if (y > LSQ_CLAMP)
+        y = LSQ_CLAMP;
+    if (y < -LSQ_CLAMP)
+        y = -LSQ_CLAMP;
+    lsphase += y;
+    lsx += lsphase;
+    lskx += k * lsphase;
+}
+
+//
+// The error over a window of n seconds, as the count's error is (10mhz
+// counts less the count, over the window), from the slope of the least
+// squares line through x[0] to x[n]:
+//
+//  slope = 12 * sum((k - n/2) * x[k]) / (n * (n+1) * (n+2))
+//        = 6 * (2 * sum(k * x[k]) - n * sum(x[k])) / (n * (n+1) * (n+2))
+//
+// and the error is -n * slope, rounded.  Starts the sums over.
+//
+static int32_t
+lsq_error (int16_t n)
+{
+    int32_t num = 2 * lskx - n * lsx;
+    int32_t d = (int32_t) (n + 1) * (n + 2);
+    int32_t q = num / d;
+    int32_t r = num % d;
+
+    lsphase = lsx = lskx = 0;
+    r *= 6;
+    return -(6 * q + (r + (r < 0 ? -d / 2 : d / 2)) / d);
+}
+#endif
+
+#if AUTO_BANDWIDTH
+// Integer square root
+static uint16_t
+isqrt (uint32_t n)
+{
+    uint32_t r = 0;
+    uint32_t b = 1UL << 30;
+
+    while (b > n)
+        b >>= 2;
+    while (b) {
+        if (n >= r + b) {
+            n -= r + b;
+            r = (r >> 1) + b;
+        } else {
+            r >>= 1;
+        }
+        b >>= 2;
+    }
+    return r;
+}
+
+// One second's count in SLOW, into the mean square change
+static void
+jitter_second (int32_t c)
+{
+    int32_t d = c - jlast;
+
+    jlast = c;
+    if (!jhave) {
+        jhave = 1;
+        return;
+    }
+    if (d > JITTER_CLAMP)
+        d = JITTER_CLAMP;
+    if (d < -JITTER_CLAMP)
+        d = -JITTER_CLAMP;
+    jvar += ((d * d << JITTER_FRAC) - jvar) >> JITTER_SHIFT;
+}
+
+//
+// The rms timestamp error in ns: the mean square change over 6, in counts
+// of 100 ns, is (jvar * 10000 / 6) >> 8 ns squared
+//
+static int16_t
+jitter_ns (void)
+{
+    return isqrt(jvar * 625 / 96);
+}
+
+//
+// Size the next SLOW window from the jitter, at the end of a window
+//
+static void
+bw_update (void)
+{
+    int16_t j = jitter_ns();
+    int16_t b = 1 + j / JITTER_STEP;
+
+    if (b < bw)                 // narrowed a quarter step late: no flapping
+        b = 1 + (j + JITTER_STEP / 4) / JITTER_STEP;
+    if (b > BW_MAX)
+        b = BW_MAX;
+    if (b > 200 / SLOW_SECONDS)
+        b = 200 / SLOW_SECONDS;     // the sum of counts fits in 32 bits
+    if (b != bw) {
+        bw = b;
+        printfs("** window ");
+        printfd(SLOW_SECONDS * bw);
+        tx(' ');
+        printfd(j);
+        nl();
+    }
+}
+
+//
+// ## jitter <ns> window <seconds>
+//
+void
+jitter_report (void)
+{
+    printfs("## jitter ");
+    printfd(jitter_ns());
+    printfs(" window ");
+    printfd(SLOW_SECONDS * SLOW_BW);
+    nl();
+}
+#endif
+
+#if PLL
+//
+// Hand SLOW over to the phase lock, from its current duty cycle
+//
+static void
+pll_start (void)
+{
+    pll = 1;
+    phase = 0;
+    pllsum = (int32_t) pwm_duty_cycle << PLL_FRAC;
+    pllrem = 0;
+    pllduty = pwm_duty_cycle;
+    printfs("** PLL");
+    nl();
+}
+
+//
+// One second of phase lock.  x is the second's offset from 10mhz, which
+// adds to the phase.  The gains, in duty cycle steps << PLL_FRAC, are
+//
+//  P = 2 * damping * steps per Hz / tau    (per count of phase)
+//  I = steps per Hz / tau^2                (per count of phase, a second)
+//
+// so the oscillator's phase, which the duty cycle moves at 1 / (steps per
+// Hz) counts a second a second, has the loop's natural frequency 1 / tau.
+// I is worked out times tau, and the integral's change divided by tau
+// with the remainder carried to the next second, so a long tau doesn't
+// round it away.  tau is held to P_FACTOR_FAST << (PLL_FRAC - PLL_I_BITS),
+// where I times tau still has PLL_I_BITS bits.  tau is widened with SLOW's
+// window.  Returns 1 at the end of a SLOW window, when a status message is
+// made.
+//
+static int
+pll_second (int32_t x)
+{
+    int32_t p, i, d;
+    int32_t tau = (int32_t) LOOP_TAU * SLOW_BW;
+
+    phase += x;
+    if (labs(phase) > PLL_MAX_PHASE) {
+        printfs("** PLL unlock ");
+        printfld(phase);
+        nl();
+        pll = 0;
+        state = SLOWINIT;
+        return 0;
+    }
+
+    if (tau > (int32_t) FAST_FACTOR << (PLL_FRAC - PLL_I_BITS))
+        tau = (int32_t) FAST_FACTOR << (PLL_FRAC - PLL_I_BITS);
+    p = ((int32_t) FAST_FACTOR << PLL_FRAC) / tau * 2 * LOOP_DAMPING / 100;
+    if (p > INT32_MAX / PLL_MAX_PHASE)
+        p = INT32_MAX / PLL_MAX_PHASE;  // past the PWM's range on a few counts
+    i = (((int32_t) FAST_FACTOR << PLL_FRAC) + tau / 2) / tau;
+    if (i > INT32_MAX / 2 / PLL_MAX_PHASE)
+        i = INT32_MAX / 2 / PLL_MAX_PHASE;
+
+    pllrem += i * phase;
+    pllsum -= pllrem / tau;
+    pllrem %= tau;
+    if (pllsum < 0)
+        pllsum = 0;
+    if (pllsum > (int32_t) 0xffff << PLL_FRAC)
+        pllsum = (int32_t) 0xffff << PLL_FRAC;
+    d = (pllsum - p * phase) >> PLL_FRAC;
+    if (d < 0)
+        d = 0;
+    if (d > 0xffff)
+        d = 0xffff;
+    if (d != pwm_duty_cycle) {
+        pwm_duty_cycle = d;
+        pwm_set(pwm_duty_cycle);
+    }
+
+    if (counter < SLOW_SECONDS * SLOW_BW)
+        return 0;
+    counter = 0;
+
+    // status message: the phase in place of the error, and the change of
+    // duty cycle over the window
+    printfs("== ");
+    printfx16(pwm_duty_cycle);
+    tx(' ');
+    printfd((int16_t) phase);
+    tx(' ');
+    printfd((int16_t) (pwm_duty_cycle - pllduty));
+    nl();
+    pllduty = pwm_duty_cycle;
+#if AUTO_BANDWIDTH
+    bw_update();
+#endif
+    return 1;
+}
+#endif
+
+//
+// States that are run repeatedly.  Called on every pass of the main loop.
+//
+void
+control_poll (void)
+{
+    // Report when state has changed
+    if (state != oldstate) {
+        printfs("> state: ");
+        printfd(oldstate);
+        printfs(" -> ");
+        printfd(state);
+        nl();
+
+        oldstate = state;
+        clear = 0;
+    }
+
+    //
+    // States that are run repeatedly
+    //
+    switch (state) {
+
+    case START:
+            /* FALL THROUGH */
+    case CHECKERRORS:   // a start-up state that checks for errors before
+                        // continuing
+            state = GOOD;   // If no error checks fail, enter GOOD state
+            /* FALL THROUGH */
+    default:
+        // Check for errors
+
+        // Check if Oscillator is cold
+#if HAVE_OSCCOLD
+        if (osc_cold()) {
+            ledstate(-1, 0, 0);     // Blue LED on
+            state = OSCCOLD;
+            break;
+        }
+#endif
+        // Check for GPS Lock Lost
+#if HAVE_GPSLOCK
+        if (gps_nolock()) {
+            ledstate(0, 0, 5);      // slow blink yellow
+            state = NOGPSLOCK;
+            break;
+        }
+#endif
+        // Check for missing 1PPS signal: no 1PPS for PPS_HOLDOFF seconds
+        // of oscillator counts (the watchdog in counter.c)
+        if (lost & LOST_PPS) {
+            ledstate(0, 0, 3);      // Slow blink yellow
+            state = NOGPSPPS;
+            break;
+        }
+
+        // Check for missing oscillator signal: timer 0 hasn't counted for
+        // OSC_HOLDOFF milliseconds of the DCO
+        if (lost & LOST_OSC) {
+            // toggle the red LED to indicate the device is functioning
+            ledstate(1, 0, 0);      // blink blue
+            state = NOOSCCLOCK;
+        }
+        break;
+
+    //
+    // The error states are left once the error has been gone for
+    // ERROR_CLEAR 1PPS seconds, counted by control_pps(), so a signal that
+    // comes and goes does not flap the state machine through CHECKERRORS.
+    //
+    case OSCCOLD:   // Oscillator is cold
+        // check if oscillator is still cold
+        if (osc_cold()) {
+            clear = 0;
+        } else if (clear >= ERROR_CLEAR) {
+            ledstate(0, 0, 0);      // blue (all) off
+            state = CHECKERRORS;
+        }
+        break;
+
+    case NOOSCCLOCK:
+        // check if there has been any clocks from the oscillator.
+        if (lost & LOST_OSC) {
+            clear = 0;
+        } else if (clear >= ERROR_CLEAR) {
+            ledstate(0, 0, 0);
+            state = CHECKERRORS;
+        }
+        break;
+
+    case NOGPSPPS:
+        // check if there has been any GPS 1PPS signals
+        //if (capture > 10 || pps) {   // yes, I've had a capture
+         // above line toggled states back and forth between CHECKERRORS and NOGPSPPS
+        if (lost & LOST_PPS) {
+            clear = 0;
+        } else if (clear >= ERROR_CLEAR) {   // I've had captures
+            ledstate(0, 0, 0);
+            state = CHECKERRORS;
+        }
+        break;
+
+    case NOGPSLOCK:
+        if (gps_nolock()) {
+            clear = 0;
+        } else if (clear >= ERROR_CLEAR) {
+            ledstate(0, 0, 0);
+            state = CHECKERRORS;
+        }
+        break;
+
+    case GOOD:
+        // State between one of the error states and one of the
+        // operational states.  State is set to GOOD by CHECKERRORS
+        // as the "no errors" state.
+        // Hand off to 1PPS based actions
+        state = FASTINIT;
+        break;
+    }
+}
+
+//
+// States that occur on a 1PPS clock.  c is the count of oscillator clocks
+// captured for the last second.
+// Returns 1 when a sample period ended and the controller acted on it.
+//
+int
+control_pps (int32_t c)
+{
+    int32_t error;              // calculated error from 10mhz
+    int16_t adjust;             // adjustment of PWM duty cycle
+    int16_t P, I;               // PID adjustment values
+    int step = 0;               // a sample period ended
+
+    if (counter >= 0) {
+        // sum clock counts only when positive.
+        // negative count allows for stabilization after changing
+        // the oscillator
+#if CAPTURE_FILTER
+        c = capture_filter(c);
+#endif
+        sum += c;
+    }
+#if AUTO_BANDWIDTH
+    // the jitter is taken from SLOW's counts, between its adjustments
+    if (state == SLOW && counter >= 0)
+        jitter_second(c);
+    else
+        jhave = 0;
+#endif
+
+    // 1 second report: Letter Count Error
+#ifdef DEBUG_SECOND
+    error = 10000000 - c;     // Error relative to a 10mhz clock rate
+    tx ('A' + counter);
+    tx (' ');
+    printfx32 (c);
+    tx (' ');
+    printfd (error);
+    tx (' ');
+    printfx32(sum);
+    nl ();
+#endif /* DEBUG_SECOND */
+#ifdef DEBUG_SEC_SHORT
+    error = 10000000 - c;     // Error relative to a 10mhz clock rate
+    printfd (error);
+    tx (' ');
+#endif
+
+    // In an error state, count the seconds of 1PPS with a second's worth
+    // of oscillator counts.  A gap in either starts the count over.
+    if (state > CHECKERRORS && state < GOOD) {
+        if (c > 10000000 - FILTER_CLAMP && c < 10000000 + FILTER_CLAMP) {
+            if (clear < ERROR_CLEAR)
+                clear++;
+        } else {
+            clear = 0;
+        }
+    }
+
+    //
+    // States that occur on a 1PPS clock
+    //
+    switch (state) {
+
+    // I could put the GOOD state here
+
+    case FASTINIT:      // initialize for fast wait
+#if CAPTURE_FILTER
+        fn = fi = 0;
+#endif
+        counter = 5;
+        state = FASTWAIT;
+        ledstate(0, 0, 1);  // set LED to yellow blink
+        lockcount = 0;
+        break;
+
+    case FASTWAIT:      // wait for counters to stabilize
+        // switching from one of the error states to here is not 
+        // synchronized with 1PPS, so the count in capture may not be
+        // good. Wait for the partial second, and for good measure 
+        // wait one more second.
+        if (--counter <= 0) {
+            // yellow LED continues to blink
+            state = FAST;
+            sum = 0;
+#if FAST_LSQ
+            lsphase = lsx = lskx = 0;
+#endif
+        }
+        break;
+
+    case FAST:
+        // FAST Synchronize to GPS 1PPS. This uses a Proportional controller and
+        // a factor that is estimated to be a full step.
+        // Count for several seconds before acting to minimize GPS jitter.
+        adjust = 0;
+        counter++;
+#if FAST_LSQ
+        if (counter > 0)
+            lsq_add(counter, c - 10000000);
+#endif
+        if (counter >= FAST_SECONDS) {
+#ifdef DEBUG_SEC_SHORT
+            nl();
+#endif
+            step = 1;
+
+            // counter is FAST_SECONDS, or more if the window was just
+            // shortened by command
+#if FAST_LSQ
+            error = lsq_error(counter);
+#else
+            error = ((int32_t) counter * 10000000) - sum;
+#endif
+            counter = 0;
+
+            //
+            // Determine LED status
+            //
+            // If error > 10 (1 in 10,000,000) : blink Yellow LED
+            // If error < 10 && > 2 (1 in ?) : slow blink Yellow LED
+            // If error <= 1 : solid on Yellow LED
+            //
+            if (labs (error) < 2) {
+                ledstate(0, 0, -1); // turn on Yellow LED
+            } else {
+                ledstate(0, 0, 1);  // blink Yellow LED
+            }
+
+            // an "error band" of +- 1
+            if (labs (error) <= P_ERRORBAND_FAST) {
+                lockcount++;
+                if (lockcount > 5) {
+                    // After no ajustments are needed for 5 seconds, switch to the
+                    // slow control program.
+                    state = SLOWINIT;
+#if AUTOTUNE
+                    // or identify the oscillator first, if that hasn't
+                    // been done
+                    if (!tuned) {
+                        state = TUNE;
+                        tlock = pwm_duty_cycle;
+                        tune_set(0);
+                        counter = -1;   // take the counts unfiltered
+                    }
+#endif
+                }
+            } else {
+                lockcount = 0;
+                if (error > FAST_MAX_ERROR)
+                	error = FAST_MAX_ERROR;
+                if (error < 0-FAST_MAX_ERROR)
+                	error = 0-FAST_MAX_ERROR;
+                // Make an adjustment.
+                // The proportional factor is tuned for 1 second samples
+                // so divide by seconds
+                adjust = (FAST_FACTOR / FAST_SECONDS) * error;
+            }
+
+            // Try to prevent underflow or overflow of the PWM duty cycle.
+            // First, by limiting the adjustment value
+            if (adjust > 32000) {
+                adjust = 32001;
+            } else if (adjust < -32000) {
+                adjust = -32000;
+            }
+
+            // second, by trying to detect overflow / underflow
+            if (adjust > 0
+                && (uint16_t) (pwm_duty_cycle + adjust) < pwm_duty_cycle) {
+                // Overflow
+                pwm_duty_cycle = 0x8001;
+            } else if (adjust < 0
+                       && (uint16_t) (pwm_duty_cycle + adjust) > pwm_duty_cycle) {
+                pwm_duty_cycle = 0x8000;
+            } else {
+                // No overflow or underflow.  Make the adjustment.
+                pwm_duty_cycle += adjust;
+            }
+
+            // status message
+            printfs("== ");
+            printfx16(pwm_duty_cycle);
+            tx(' ');
+            printfd(error);
+            tx(' ');
+            printfd(adjust);
+            nl();
+
+            if (adjust) {
+                pwm_set(pwm_duty_cycle);
+                // If an adjustment was made, skip the current second's count
+                // (and any the oscillator takes to settle), unless the PWM
+                // filter settles at its start (PWM_SETTLE)
+                counter = -FAST_SETTLE;
+#if CAPTURE_FILTER
+                fn = fi = 0;    // and start the outlier filter over
+#endif
+            }
+            sum = 0;
+        }
+        break;
+
+#if AUTOTUNE
+    case TUNE:
+        // Identify the oscillator, then lock again with the new gains
+        error = c - 10000000;
+        if (error > FILTER_CLAMP)
+            error = FILTER_CLAMP;
+        if (error < -FILTER_CLAMP)
+            error = -FILTER_CLAMP;
+        if (tune_second(error)) {
+            step = 1;
+            pwm_duty_cycle = tlock;
+            state = FASTINIT;
+        }
+        break;
+#endif
+
+    case SLOWINIT:
+        // initialize for slow control program.
+        slowlock = 0;
+        sum = 0;
+        Ihist = 0;
+#if PLL
+        pll = 0;
+#endif
+        ledstate(0, 1, 0);
+        state = SLOW;
+        counter = -2;
+
+        /* FALL THROUGH */
+    case SLOW:
+        // Slow tracking of GPS.  Measures offset from GPS over a minute
+        // and makes small adjustments.
+        // The P factor is typically 5% of the full step between frequencies.
+        counter++;
+#if PLL
+        if (pll) {
+            if (counter > 0)
+                step = pll_second(c - 10000000);
+            sum = 0;
+            break;
+        }
+#endif
+    	if (counter >= SLOW_SECONDS * SLOW_BW) {
+#ifdef DEBUG_SEC_SHORT
+            nl();
+#endif
+            step = 1;
+            error = ((int32_t) counter * 10000000) - sum;
+#ifdef DEBUG
+            printfs("S ");
+            printfx32 (sum);
+            tx(' ');
+            printfd(error);
+            nl();
+#endif /* DEBUG */
+
+            counter = 0;
+            sum = 0;
+
+            if (labs(error) > 128 * SLOW_BW) {  // glitch or something. 
+                // may need to lower this to catch drift problems that
+                // should cause switching back to FAST
+                state = FASTINIT;
+                printfs("** ERROR ");
+                printfx32 (error);
+                nl();
+            } else {
+            	adjust = 0;
+            	P = I = 0;
+                // Proportional control, based on the 1 minute error
+                // (per minute of a wider window).
+            	if (labs(error) > SLOW_P_BAND) {
+            		P = error * SLOW_P_FACTOR / SLOW_BW;
+            	}
+
+                // Integral control
+                // Look at the last several minutes of error data
+                // for a trend + or -. When there is a trend of
+                // errors in one direction, make an adjustment.
+
+                // Integral history & calculation:
+                // When the error is positive or negative, and the I history
+                // matches (pos/neg), then increase the count in the direction
+                // of the error.
+                // If it flips from +1 to -1 (or -1 to +1), this require an extra
+                // cycle before counting.
+                if (error < 0 && Ihist <= 0) {
+                    Ihist--;
+                } else if (error > 0 && Ihist >= 0) {
+                    Ihist++;
+                } else {
+                    Ihist = 0;
+                }
+
+                if (abs(Ihist) > SLOW_I_BAND) {
+                    I = SLOW_I_FACTOR * Ihist;
+                }
+
+                adjust = P + I;
+                if (adjust) {
+                    slowlock = 0;
+                    ledstate(0, 1, 0);
+                } else {
+                    // no adjustment - move to slower blinking green
+                    adjust = 0;
+                    slowlock++;
+                    //ledstate(0, slowlock > 4 ? -1 : slowlock, 0);
+                    ledstate(0, -1, 0);
+#if PLL
+                    if (slowlock >= PLL_LOCK)
+                        pll_start();
+#endif
+                }
+
+                if (adjust) {
+                    pwm_duty_cycle += adjust;
+                    pwm_set(pwm_duty_cycle);
+                    counter = -PWM_SETTLE;
+                }
+
+#ifdef DEBUG_PID
+                printfs("** ");
+                printfd(error);
+                tx(' ');
+                printfd(P);
+                tx(' ');
+                printfd(I);
+                tx(' ');
+                printfd(Ihist);
+                tx(' ');
+                printfd(adjust);
+                tx(' ');
+                printfx16(pwm_duty_cycle);
+                nl();
+#endif
+
+                // status message
+                printfs("== ");
+                printfx16(pwm_duty_cycle);
+                tx(' ');
+                printfd(error);
+                tx(' ');
+                printfd(adjust);
+                nl();
+            }
+#if AUTO_BANDWIDTH
+            bw_update();
+#endif
+        }
+        break;
+    }
+    return step;
+}
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 
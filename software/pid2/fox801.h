@@ -0,0 +1,28 @@
+/*
+ * fox801.h - pid2 controller constants for the Fox 801
+ *
+ * Copyright 2014-2017 Glen Overby
+ * 
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#define P_FACTOR_FAST   284		// calculated 284
+#define	P_ERRORBAND_FAST 1
+#define P_MAX_ERROR		920		// maximum error value (per second) before counter overflow  (32768/P_FACTOR_FAST*SEC)
+#define P_FACTOR_SLOW	5
+#define P_ERRORBAND_SLOW 10
+#define I_FACTOR_SLOW   1
+#define I_ERRORBAND_SLOW 1
+#define HAVE_GPSLOCK 	0
+#define HAVE_OSCCOLD 	0
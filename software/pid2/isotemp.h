@@ -0,0 +1,29 @@
+/*
+ * isotemp.h - pid2 controller constants for the Isotemp 134-10
+ *
+ * Copyright 2014-2017 Glen Overby
+ * 
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#define P_FACTOR_FAST   2500 //5000
+#define	P_ERRORBAND_FAST 1
+#define P_MAX_ERROR		393		// maximum error value (per second) before counter overflow  (32768/P_FACTOR_FAST*SEC)
+#define P_FACTOR_SLOW	50
+#define P_ERRORBAND_SLOW 1
+#define I_FACTOR_SLOW   25
+	// tried: 50 - may have set up an oscillation
+#define I_ERRORBAND_SLOW 1
+#define HAVE_GPSLOCK 0
+#define HAVE_OSCCOLD 1
@@ -17,9 +17,8 @@
  *
  */
 
-#include <msp430.h>
-#include <stdio.h>
-#include <string.h>
+#include "gpsdo.h"
+#include "pid2.h"
 
 /*
  * Hardware Map
@@ -28,7 +27,7 @@
  * P1.0 TACLK (input)
  * P1.1 1PPS input
  * P1.2 Serial out
- * P1.3 Button (input)
+ * P1.3 Button (input), or the comparison input (COMPARE_INPUT)
  * P1.4 SMCLK (output)
  * P1.5 LED 3: Red (new)
  * P1.6 LED 2: Green
@@ -37,7 +36,14 @@
  * P2.0 input - OSC Good - high when oscillator is cold
  * P2.1 input - GPS Lock
  * P2.2 PWM Output from timer 1
+ * P2.4 Serial in, for the command interface (COMMANDS)
  * P2.5 output LED4: Blue - OSC Good
+ * P2.6 XIN: 10mhz from the oscillator, for the PWM (OSC_CLOCK)
+ *
+ * With SPI_DAC, the DAC takes P1.5 and P1.7 (and P2.3 for chip select),
+ * so the red LED moves to P2.7 and the yellow to P2.2, free of the PWM.
+ * With PPS_OUT, the 1PPS output takes P1.6, so the green LED moves to P2.3
+ * (P2.6 with SPI_DAC).
  *
  * GPSlock: PC0 low when data is good
  *          PC1 high when data is good
@@ -51,7 +57,7 @@
  *  Blue is on when OSC is cold
  *  Blue blinks if there is no 10mhz clock from the oscillator
  *
- *  Yellow blinks slow if no GPS Lock or No GPS PPS
+ *  Yellow flashes every 2 seconds if no GPS PPS, twice if no GPS Lock
  *  Yellow blinks when fast algorithm is seeking
  *  Yellow on when fast algorithm has abs(error) < 1
  *
@@ -59,52 +65,10 @@
  *  Green on when no adjustment has been made for 1 minute
  */
 
-//#define DEBUG_SECOND
-#define DEBUG_SEC_SHORT
-//#define DEBUG
-#define DEBUG_PID
-
-/* Controller constants */
-
-/*
- * P_FACTOR_FAST was calculated by using a binary search to find frequencies.
- * Slow is 1/20th of that.
- */
-
-/* Isotemp */
-#if 1
-#define P_FACTOR_FAST   2500 //5000
-#define	P_ERRORBAND_FAST 1
-#define P_MAX_ERROR		393		// maximum error value (per second) before counter overflow  (32768/P_FACTOR_FAST*SEC)
-#define P_FACTOR_SLOW	50
-#define P_ERRORBAND_SLOW 1
-#define I_FACTOR_SLOW   25
-	// tried: 50 - may have set up an oscillation
-#define I_ERRORBAND_SLOW 1
-#define HAVE_GPSLOCK 0
-#define HAVE_OSCCOLD 1
-#endif
-#if 0
-/* Fox 801 */
-#define P_FACTOR_FAST   284		// calculated 284
-#define	P_ERRORBAND_FAST 1
-#define P_MAX_ERROR		920		// maximum error value (per second) before counter overflow  (32768/P_FACTOR_FAST*SEC)
-#define P_FACTOR_SLOW	5
-#define P_ERRORBAND_SLOW 10
-#define I_FACTOR_SLOW   1
-#define I_ERRORBAND_SLOW 1
-#define HAVE_GPSLOCK 	0
-#define HAVE_OSCCOLD 	0
-#endif
-
-#define USELED	0
-#define SAMPLE_SECONDS  8
-#define SAMPLE_MINUTE	60
-
-//#define DEBUG_SECOND  1
-
-#define X12MHZ 0
-#define X16MHZ 1
+#define ISR_REPORT  600         // seconds between interrupt statistics reports
+#define PPS_REPORT  60          // seconds between 1PPS output offset reports
+#define VALID_REPORT 600        // seconds between 1PPS validation reports
+#define JITTER_REPORT 60        // seconds between 1PPS jitter reports
 
 /* Hardware Port definitions */
 #define P1Button    0x80
@@ -116,209 +80,117 @@
 #define P2GPSLOCK   0x02        // GPS Lock - high when no lock
 #define P2LED4      0x20        // Blue LED
 
-// State Machine
-#define START       0
-#define CHECKERRORS 1
-#define OSCCOLD     2
-#define NOOSCCLOCK  3
-#define NOGPSPPS    4
-#define NOGPSLOCK   5
-#define GOOD        6
-// Below states run only on 1PPS clock
-#define FASTINIT    7
-#define FASTWAIT    8
-#define FAST        9
-#define SLOWINIT    10
-#define SLOW        11
-
+#if SPI_DAC
+#define RED_OUT     P2OUT
+#define RED         0x80        // P2.7
+#define YELLOW_OUT  P2OUT
+#define YELLOW      0x04        // P2.2
+#else
+#define RED_OUT     P1OUT
+#define RED         P1LED3
+#define YELLOW_OUT  P1OUT
+#define YELLOW      P1LED1
+#endif
 
-//
-//  Data for interrupt handlers
-//
-volatile long count = 0;                 // counter for 10mhz clock.  Managed by counter overflow interrupt handler
-volatile long countadd = 0x10000;        // value to add to count on overflow.
-                                // the only time this value is not 65536 is when the 1pps signal arrives.
-                                // it is then set to 65536 - captured count.
-volatile long capture = 0;               // captured count
-volatile char pps = 0;                   // counter from 1pps handler.  Used to detect no 10mhz clock.
-char blinkcounter = 0;       // interrupt blink counter
-char blink_blue = 0;
-char blink_green = 0;
-char blink_yellow = 0;
-char bcg = 0;
-char bcb = 0;
-char bcy = 0;
+#if PPS_OUT
+#define GREEN_OUT   P2OUT
+#if SPI_DAC
+#define GREEN       0x40        // P2.6
+#else
+#define GREEN       0x08        // P2.3
+#endif
+#else
+#define GREEN_OUT   P1OUT
+#define GREEN       P1LED2
+#endif
 
 //
-// Basic Output: character, string, decimal, hex (4, 16, and 32 bits)
-// printf for basic format types.  Calls to printf are expensive, these are shortcuts.
+// LEDs.  ledstate() gives each LED a blink pattern, a bit for each LED_STEP
+// of a 2 second cycle, the low bit first, and led_poll() steps through the
+// patterns from the main loop on the timer 1 tick, so the LEDs cost nothing
+// in the interrupt handlers.
 //
+#define LED_STEP        TICKS_MS(125)   // ticks a pattern bit lasts
 
-// blocking character transmit.
-void
-tx (char c)
-{
-    while (!(IFG2 & UCA0TXIFG));        // USCI_A0 TX buffer ready?
-    UCA0TXBUF = c;              // TX -> character
-}
-
-// printf(%x) of 1 digit.
-void
-printfx4 (int v)
-{
-    v &= 0xf;
-    v += '0';
-    if (v > '9')
-        v += 7;
-    tx ((char) v);
-}
-
-// printf(%x) of 16-bit word.
-void
-printfx16 (int v)
-{
-    printfx4 (v >> 12);
-    printfx4 (v >> 8 & 0xf);
-    printfx4 (v >> 4 & 0xf);
-    printfx4 (v & 0xf);
-}
-
-// printf(%x) of 32-bit word.
-void
-printfx32 (long v)
-{
-    printfx16 (v >> 16);
-    printfx16 (v & 0xffff);
-}
+#define LED_OFF         0x0000
+#define LED_ON          0xffff
+#define LED_BLINK       0x00ff  // one second on, one off
+#define LED_FLASH       0x0003  // a short flash every 2 seconds
+#define LED_FLASH2      0x0033  // two short flashes every 2 seconds
 
-// printf(%d)
-void
-printfd (int v)
-{
-    char output[16];
-    void printfs (char *c);
-    sprintf (output, "%d", v);
-    printfs (output);
-}
+static uint16_t led_blue, led_green, led_yellow;        // patterns
+static uint16_t led_tick;       // tick of the last step
+static unsigned char led_bit;   // pattern bit shown
 
-// printf(%s)
-void
-printfs (char *c)
+// Pattern for a ledstate() value
+static uint16_t
+led_pattern(int v)
 {
-    for (; *c; c++) {
-        if (*c == '\n')
-            tx ('\r');
-        tx (*c);
+    switch (v) {
+    case 0:     return LED_OFF;
+    case -1:
+    case 10:    return LED_ON;
+    case 3:     return LED_FLASH;   // no 1PPS
+    case 5:     return LED_FLASH2;  // no GPS lock
+    default:    return LED_BLINK;
     }
 }
 
-// newline (CR & LF)
-void
-nl ()
-{
-    tx ('\r');
-    tx ('\n');
-}
-
 // 
 // Set blink state
 //
+//  0   off
+//  -1  on (10 too, for blue)
+//  1   blink
+//  3   a flash every 2 seconds
+//  5   two flashes every 2 seconds
+//
 void
 ledstate(int blue, int green, int yellow)
 {
-    switch(blue) {
-    case 0:     P2OUT &= ~0x20;         // Blue LED off
-        break;
-    case 10:
-    case -1:    P2OUT |= 0x20;          // Blue LED on
-        break;
-    }
-    blink_blue = blue;
-
-#if USELED
-    switch(green) {
-    case 0:
-    	P1OUT &= ~0x40;         // Green LED off
-    	bcg = 0;
-        break;
-    case -1:
-    	P1OUT |= 0x40;          // Green LED on
-    	bcg = 0;
-        break;
-    default:
-    	bcg = green;
-    }
-    blink_green = green;
+    led_blue = led_pattern(blue);
+    led_green = led_pattern(green);
+    led_yellow = led_pattern(yellow);
+    led_bit = 15;               // start the patterns at the next step
+}
 
-    switch(yellow) {
-    case 0:
-    	P1OUT &= ~0x80;         // Yellow LED off
-    	bcy = 0;
-        break;
-    case -1:
-    	P1OUT |= 0x80;          // Yellow LED on
-    	bcy = 0;
-        break;
-    default:
-    	bcy = yellow;
-    }
-    blink_yellow = yellow;
-#endif /* USELED */
+//
+// Show the next step of the patterns.  Called from the main loop.
+//
+static void
+led_poll(void)
+{
+    uint16_t m;
+
+    if ((uint16_t) (ticks - led_tick) < LED_STEP)
+        return;
+    led_tick = ticks;
+    led_bit = (led_bit + 1) & 15;
+    m = 1 << led_bit;
+
+    if (led_blue & m)
+        P2OUT |= P2LED4;
+    else
+        P2OUT &= ~P2LED4;
+    if (led_green & m)
+        GREEN_OUT |= GREEN;
+    else
+        GREEN_OUT &= ~GREEN;
+    if (led_yellow & m)
+        YELLOW_OUT |= YELLOW;
+    else
+        YELLOW_OUT &= ~YELLOW;
 }
 
 //
 // Configure the microcontroller ports.
 //
-int
-config(void)
+void
+config(unsigned int duty)
 {
-    WDTCTL = WDTPW | WDTHOLD;   // Stop watchdog timer
-
-    // Set processor clock speed
-    // From TI's example program: msp430g2xx3_dco_calib
-    //12Mhz
-    if (CALBC1_12MHZ == 0xFF)   // If calibration constant erased
-    {
-        return (1);             // do not load, trap CPU!!
-    }
-    DCOCTL = 0;                 // Select lowest DCOx and MODx settings
-#if X12MHZ
-    BCSCTL1 = CALBC1_12MHZ;     // Set range
-    DCOCTL = CALDCO_12MHZ;      // Set DCO step + modulation*/
-#endif
-#if X16MHZ
-    BCSCTL1 = CALBC1_16MHZ;     // Set range
-    DCOCTL = CALDCO_16MHZ;      // Set DCO step + modulation*/
-#endif
-
-    // Configure Timer TA0 to count clock pulses on P1.0 with a capture input on P1.1.
-    // From TI's example program: msp430g2xx3_ta_03.c (with modifications)
-    TA0CTL = MC_2 + TAIE;       // TACLK, continuous mode, interrupt
-    P1SEL |= 0x01;              // Function: TA0.TACLK
-
-    // Enable Capture/Compare register 0
-    TA0CCTL0 = CM1 | SCS | CAP | CCIE;  // Capture on CCIxA on falling edge, synchronous
-    TA0CCTL1 = 0;
-    TA0CCTL2 = 0;
-
-    P1DIR &= ~0x02;             // input
-    P1SEL |= 0x02;              // Function: CCI0A
-
-    //P1DIR &= ~0x08;                                                   // P1.3 (Button) as an input
-    //P1REN |= 0x08;                                                    // P1.3 pull-up resistor enable
-
-    // PWM using timer 1 on P2.2-10
-    // This goes through a low-pass filter and connects to the oscillator's voltage
-    // control input.
-    // From TI's example program: msp430g2xx3_ta_16.c (with modifications)
-    P2DIR |= 0x04;              // P2.2 output
-    P2SEL |= 0x04;              // P2.2 TA1 options
-    TA1CCR0 = 65535;            // PWM Period
-
-
-    TA1CCTL1 = OUTMOD_7;        // CCR1 reset/set
-    TA1CCR1 = 1;
-    TA1CTL = TASSEL_2 + MC_1;   // SMCLK, up mode - counts to TA1CCR0
+    clock_init();
+    counter_init();
+    pwm_init(duty);
 
     P1DIR |= 0xf0;              // P1.6 is LED2, P1.7 is LED1 (new), P1.5 is POWER
     P1OUT &= ~0xf0;
@@ -326,501 +198,194 @@ config(void)
     P2DIR &= ~0x02;             // P2.1 input - GPS Lock
     P2DIR |= 0x20;              // P2.5 output - OSC Good (Blue)
     P2OUT &= ~0x20;             // turn Blue LED off
-
-    // Serial port from TI's example program: msp430g2xx3_uscia0_uart_01_9600 (modified)
-    P1SEL |= BIT2;              // P1.2=TXD
-    P1SEL2 |= BIT2;             // P1.2=TXD
-    UCA0CTL1 |= UCSSEL_2;       // Uart clock from SMCLK
-#if X12MHZ
-    UCA0BR0 = 0xe0;             // 12MHz 9600
-    UCA0BR1 = 4;                // 12MHz 9600
+#if SPI_DAC
+    P2SEL &= ~0xc0;             // P2.6, P2.7 I/O rather than XIN, XOUT
+    P2DIR |= RED | YELLOW;      // P2.7 Red, P2.2 Yellow
+    P2OUT &= ~(RED | YELLOW);
 #endif
-#if X16MHZ
-    UCA0BR0 = 0x80;             // 16MHz 9600
-    UCA0BR1 = 6;                // 16MHz 9600
+#if PPS_OUT
+    P2DIR |= GREEN;
+    P2OUT &= ~GREEN;
 #endif
-    UCA0MCTL = UCBRS0;          // Modulation UCBRSx = 1
-    UCA0CTL1 &= ~UCSWRST;       // **Initialize USCI state machine**
-    //IE2 |= UCA0RXIE;                          // Enable USCI_A0 RX interrupt
 
-    UCA0TXBUF = '!';
+    uart_init();
+#if COMMANDS
+    rx_init();
+#endif
     nl ();
 
-    P1OUT |= 0x20;              // turn on power/status LED
+    RED_OUT |= RED;             // turn on power/status LED
 
+    watchdog_init();
     //_BIS_SR(LPM0_bits + GIE);                 // Enter LPM0 w/ interrupt
     _BIS_SR (GIE);              // Enable interrupt
-    return 0;
 }
 
+//
+// Oscillator and GPS status inputs
+//
 int
-main (void)
+osc_cold(void)
 {
-    unsigned int pwm_duty_cycle = 1;    // PWM duty cycle ~ voltage
-    long sum = 0;               // sum of captured counts during (counter) pulses
-    long wlc = 0;               // loop counter - experimental counter.  0x40961 iterations per second
-    int counter = -10;          // count of 1pps pulses before acting.
-    char lockcount = 0;         // iterations that had lock.
-
-    //  initialized to a value not used by the state check
-    char state = 0;             // state machine
-    char oldstate = 0;          //   previous state, for reporting changes
+    return P2IN & P2OSC;
+}
 
-    long error;                 // calculated error from 10mhz
-    int adjust;                 // adjustment of PWM duty cycle
-    int P, I;			// PID adjustment values
-    int Ihist;                  // I history
+int
+gps_nolock(void)
+{
+    return P2IN & P2GPSLOCK;
+}
 
-    char slowlock = 0;		// number of minutes with no adjustment
+// Check word of len bytes (even) at p, starting from magic
+static uint16_t
+check (uint16_t magic, const void *p, unsigned int len)
+{
+    const uint16_t *w = (const uint16_t *) p;
+    uint16_t c = magic;
+    unsigned int i;
 
-    config();
+    for (i = 0; i < len / 2; i++)
+        c = (c << 1 | c >> 15) ^ w[i];
+    return c;
+}
 
-    printfs("PID2-reorg-0703"); nl();
+//
+// Controller state kept over a watchdog reset, in RAM the startup code
+// leaves alone.  It is saved each second and used after a watchdog reset
+// if its check word matches.
+//
+#define RESUME_MAGIC    0x7273
 
-    TA1CCR1 = pwm_duty_cycle;
-    ledstate(0,0,0);
+struct resume_ram {
+    struct resume r;
+    uint16_t check;
+};
 
-    capture = 0;
-    counter = -1;
-    while (1) {
-        wlc++;
-        // Report when state has changed
-        if (state != oldstate) {
-            printfs("> state: ");
-            printfd(oldstate);
-            printfs(" -> ");
-            printfd(state);
-            nl();
-
-            oldstate = state;
-        }
+NOINIT(struct resume_ram, saved);
 
-        //
-        // States that are run repeatedly
-        //
-        switch (state) {
-
-        case START:
-                /* FALL THROUGH */
-        case CHECKERRORS:   // a start-up state that checks for errors before
-                            // continuing
-                state = GOOD;   // If no error checks fail, enter GOOD state
-                /* FALL THROUGH */
-        default:
-            // Check for errors
-
-            // Check if Oscillator is cold
-#if HAVE_OSCCOLD
-            if (P2IN & P2OSC) {
-                ledstate(-1, 0, 0);     // Blue LED on
-                state = OSCCOLD;
-                break;
-            }
-#endif
-            // Check for GPS Lock Lost
-#if HAVE_GPSLOCK
-            if (P2IN & P2GPSLOCK) {
-                ledstate(0, 0, 5);      // slow blink yellow
-                state = NOGPSLOCK;
-                break;
-            }
-#endif
-            // Check for missing 1PPS signal
-            if (count > 150000000) {     // If no PPS clocks for 15 seconds
-                ledstate(0, 0, 3);      // Slow blink yellow
-                state = NOGPSPPS;
-            }
+#if TUNABLE
+//
+// Auto-tuned gains, or those saved by command, kept in information flash
+// segment D.  Erase the segment (mspdebug "erase segment 0x1000") to go
+// back to the defaults (and tune again).
+//
+#define TUNE_MAGIC      0x7475
 
-#if 0
-// >> Test this
-            // Check for missing 1PPS signal
-            // loop count measured at 264545/second.
-            if (wlc > 2645450) {        // If no PPS clocks for 10 seconds
-                ledstate(0, 0, 3);      // Slow blink yellow
-                state = NOGPSPPS;
-                printfs("loop count PPS check failed\n");
-            }
-#endif
+struct tune_flash {
+    uint16_t magic;
+    struct tune t;
+    uint16_t check;
+};
 
-            // Check for missing oscillator signal
-            if (pps > 14) {
-                // 15 seconds of clocks from GPS but no 10mhz clock pulses
-                // toggle the red LED to indicate the device is functioning
-                ledstate(1, 0, 0);      // blink blue
-                state = NOOSCCLOCK;
-                pps = 0;
-            }
-            break;
+#define tune_check(t)   check(TUNE_MAGIC, t, sizeof(struct tune))
 
-        case OSCCOLD:   // Oscillator is cold
-            // check if oscillator is still cold
-            if ((P2IN & P2OSC) == 0) {
-                ledstate(0, 0, 0);      // blue (all) off
-                state = CHECKERRORS;
-            }
-            break;
-
-        case NOOSCCLOCK:
-            // check if there has been any clocks from the oscillator.  
-            // The 'pps' counter is tracked for this purpose: it is set by
-            // the 1pps interrupt, and is reset when there is a non-zero
-            // capture count.
-            if (pps) {
-                ledstate(0, 0, 0);
-                state = CHECKERRORS;
-            }
-            break;
-
-        case NOGPSPPS:
-            // check if there has been any GPS 1PPS signals
-            //if (capture > 10 || pps) {   // yes, I've had a capture
-             // above line toggled states back and forth between CHECKERRORS and NOGPSPPS
-            if (pps) {   // I've had a capture
-                ledstate(0, 0, 0);
-                state = CHECKERRORS;
-            }
-            break;
+int
+tune_load (struct tune *t)
+{
+    const struct tune_flash *f = INFO_D;
 
-        case NOGPSLOCK:
-            if ((P2IN & P2GPSLOCK) == 0) {
-                ledstate(0, 0, 0);
-                state = CHECKERRORS;
-            }
-            break;
-
-        case GOOD:
-            // State between one of the error states and one of the
-            // operational states.  State is set to GOOD by CHECKERRORS
-            // as the "no errors" state.
-            // Hand off to 1PPS based actions
-            state = FASTINIT;
-            break;
-        }
+    if (f->magic != TUNE_MAGIC || f->check != tune_check(&f->t))
+        return 0;
+    *t = f->t;
+    return 1;
+}
 
-        // Look for a 1PPS signal
-        if (capture != 0) { // && state > GOOD
-            pps = 0;                        // reset pps counter.
-                                            // used as oscillator loss check
-
-            if (counter >= 0) {
-                // sum clock counts only when positive.
-                // negative count allows for stabilization after changing
-                // the oscillator
-                sum += capture;
-            }
+void
+tune_save (const struct tune *t)
+{
+    struct tune_flash f;
 
-            // 1 second report: Letter Count Error
-#ifdef DEBUG_SECOND
-            error = 10000000 - capture;     // Error relative to a 10mhz clock rate
-            tx ('A' + counter);
-            tx (' ');
-            printfx32 (capture);
-            tx (' ');
-            printfd (error);
-            tx (' ');
-            //printfx32 (wlc);     // while(1) loop counter.  see about using it
-                                // as a fault detection counter.
-            printfx32(sum);
-            nl ();
-#endif /* DEBUG_SECOND */
-#ifdef DEBUG_SEC_SHORT
-            error = 10000000 - capture;     // Error relative to a 10mhz clock rate
-            printfd (error);
-            tx (' ');
+    f.magic = TUNE_MAGIC;
+    f.t = *t;
+    f.check = tune_check(t);
+    flash_write(INFO_D, &f, sizeof(f));
+}
 #endif
 
-            capture = 0;
-            wlc = 0;
-
-            //
-            // States that occur on a 1PPS clock
-            //
-            switch (state) {
-
-            // I could put the GOOD state here
-
-            case FASTINIT:      // initialize for fast wait
-                counter = 5;
-                state = FASTWAIT;
-                ledstate(0, 0, 1);  // set LED to yellow blink
-                lockcount = 0;
-                break;
-
-            case FASTWAIT:      // wait for counters to stabilize
-                // switching from one of the error states to here is not 
-                // synchronized with 1PPS, so the count in capture may not be
-                // good. Wait for the partial second, and for good measure 
-                // wait one more second.
-                if (--counter <= 0) {
-                    // yellow LED continues to blink
-                    state = FAST;
-                    sum = 0;
-                }
-                break;
-
-            case FAST:
-                // FAST Synchronize to GPS 1PPS. This uses a Proportional controller and
-                // a factor that is estimated to be a full step.
-                // Count for several seconds before acting to minimize GPS jitter.
-                adjust = 0;
-                counter++;
-                if (counter >= SAMPLE_SECONDS) {
-#ifdef DEBUG_SEC_SHORT
-                    nl();
+int
+main (void)
+{
+#ifdef ISR_STATS
+    int seconds = 0;            // seconds since the last statistics report
 #endif
-                    counter = 0;
-
-                    error = (SAMPLE_SECONDS * 10000000) - sum;
-
-                    //
-                    // Determine LED status
-                    //
-                    // If error > 10 (1 in 10,000,000) : blink Yellow LED
-                    // If error < 10 && > 2 (1 in ?) : slow blink Yellow LED
-                    // If error <= 1 : solid on Yellow LED
-                    //
-                    if (abs (error) < 2) {
-                        ledstate(0, 0, -1); // turn on Yellow LED
-                    } else {
-                        ledstate(0, 0, 1);  // blink Yellow LED
-                    }
-
-                    // an "error band" of +- 1
-                    if (abs (error) <= P_ERRORBAND_FAST) {
-                        lockcount++;
-                        if (lockcount > 5) {
-                            // After no ajustments are needed for 5 seconds, switch to the
-                            // slow control program.
-                            state = SLOWINIT;
-                        }
-                    } else {
-                        lockcount = 0;
-                        if (error > P_MAX_ERROR)
-                        	error = P_MAX_ERROR;
-                        if (error < 0-P_MAX_ERROR)
-                        	error = 0-P_MAX_ERROR;
-                        // Make an adjustment.
-                        // The proportional factor is tuned for 1 second samples
-                        // so divide by seconds
-                        adjust = (P_FACTOR_FAST / SAMPLE_SECONDS) * error;
-                    }
-
-                    // Try to prevent underflow or overflow of the PWM duty cycle.
-                    // First, by limiting the adjustment value
-                    if (adjust > 32000) {
-                        adjust = 32001;
-                    } else if (adjust < -32000) {
-                        adjust = -32000;
-                    }
-
-                    // second, by trying to detect overflow / underflow
-                    if (adjust > 0
-                        && pwm_duty_cycle + adjust < pwm_duty_cycle) {
-                        // Overflow
-                        pwm_duty_cycle = 0x8001;
-                    } else if (adjust < 0
-                               && pwm_duty_cycle + adjust > pwm_duty_cycle) {
-                        pwm_duty_cycle = 0x8000;
-                    } else {
-                        // No overflow or underflow.  Make the adjustment.
-                        pwm_duty_cycle += adjust;
-                    }
-
-                    // status message
-                    printfs("== ");
-                    printfx16(pwm_duty_cycle);
-                    tx(' ');
-                    printfd(error);
-                    tx(' ');
-                    printfd(adjust);
-                    nl();
-
-                    if (adjust) {
-                        TA1CCR1 = pwm_duty_cycle;
-                        // If an adjustment was made, skip the current second's count
-                        counter = -1;
-                    }
-                    sum = 0;
-                }
-                break;
-
-            case SLOWINIT:
-                // initialize for slow control program.
-                slowlock = 0;
-                sum = 0;
-                Ihist = 0;
-                ledstate(0, 1, 0);
-                state = SLOW;
-                counter = -2;
-
-                /* FALL THROUGH */
-            case SLOW:
-                // Slow tracking of GPS.  Measures offset from GPS over a minute
-                // and makes small adjustments.
-                // The P factor is typically 5% of the full step between frequencies.
-                counter++;
-            	if (counter >= SAMPLE_MINUTE) {
-#ifdef DEBUG_SEC_SHORT
-                    nl();
+#if PPS_OUT
+    int ppsseconds = 0;         // seconds since the last 1PPS output report
 #endif
-                    error = (60 * 10000000) - sum;
-#ifdef DEBUG
-                    printfs("S ");
-                    printfx32 (sum);
-                    tx(' ');
-                    printfd(error);
-                    nl();
-#endif /* DEBUG */
-
-                    counter = 0;
-                    sum = 0;
-
-                    if (abs(error) > 128) {  // glitch or something. 
-                        // may need to lower this to catch drift problems that
-                        // should cause switching back to FAST
-                        state = FASTINIT;
-                        printfs("** ERROR ");
-                        printfx32 (error);
-                        nl();
-                    } else {
-                    	adjust = 0;
-                    	P = I = 0;
-                        // Proportional control, based on the 1 minute error.
-                    	if (abs(error) > P_ERRORBAND_SLOW) {
-                    		P = error * P_FACTOR_SLOW;
-                    	}
-
-                        // Integral control
-                        // Look at the last several minutes of error data
-                        // for a trend + or -. When there is a trend of
-                        // errors in one direction, make an adjustment.
-
-                        // Integral history & calculation:
-                        // When the error is positive or negative, and the I history
-                        // matches (pos/neg), then increase the count in the direction
-                        // of the error.
-                        // If it flips from +1 to -1 (or -1 to +1), this require an extra
-                        // cycle before counting.
-                        if (error < 0 && Ihist <= 0) {
-                            Ihist--;
-                        } else if (error > 0 && Ihist >= 0) {
-                            Ihist++;
-                        } else {
-                            Ihist = 0;
-                        }
-
-                        if (abs(Ihist) > I_ERRORBAND_SLOW) {
-                            I = I_FACTOR_SLOW * Ihist;
-                        }
-
-                        adjust = P + I;
-                        if (adjust) {
-                            slowlock = 0;
-                            ledstate(0, 1, 0);
-                        } else {
-                            // no adjustment - move to slower blinking green
-                            adjust = 0;
-                            slowlock++;
-                            //ledstate(0, slowlock > 4 ? -1 : slowlock, 0);
-                            ledstate(0, -1, 0);
-                        }
-
-                        if (adjust) {
-                            pwm_duty_cycle += adjust;
-                            TA1CCR1 = pwm_duty_cycle;
-                            counter = -1;
-                        }
-
-#ifdef DEBUG_PID
-                        printfs("** ");
-                        printfd(error);
-                        tx(' ');
-                        printfd(P);
-                        tx(' ');
-                        printfd(I);
-                        tx(' ');
-                        printfd(Ihist);
-                        tx(' ');
-                        printfd(adjust);
-                        tx(' ');
-                        printfx16(pwm_duty_cycle);
-                        nl();
+#if PPS_VALIDATE
+    int validseconds = 0;       // seconds since the last validation report
+#endif
+#if AUTO_BANDWIDTH
+    int jitterseconds = 0;      // seconds since the last jitter report
 #endif
 
-                        // status message
-                        printfs("== ");
-                        printfx16(pwm_duty_cycle);
-                        tx(' ');
-                        printfd(error);
-                        tx(' ');
-                        printfd(adjust);
-                        nl();
-                    }
-                }
-                break;
-            }
-        }
-    }
-}
-
-// From TI's example program: msp430g2xx3_ta_03.c (with modifications)
-// Timer_A3 Interrupt Vector (TA0IV) handler
-// The 10mhz clock is to be connected to it's count input.
-#pragma vector=TIMER0_A1_VECTOR
-__interrupt void
-Timer_A (void)
-{
-    switch (TA0IV) {
-    case 2:                     // CCR1 capture
-        break;
-    case 4:
-        break;                  // CCR2
-    case 10:                    // counter overflow
-        count += countadd;      // add remaining (or full) count
-        countadd = 0x10000;     // set count to a full count.
-        break;
-    }
-}
-
-// Interrupt vector for capture/compare register 0
-// 1PPS is to be connected here.
-#pragma vector=TIMER0_A0_VECTOR
-__interrupt void
-Timer_A0 (void)
-{
-    unsigned int c;
-    c = TA0CCR0;                // get capture value
+    struct resume r;
+    char resumed = 0;
 
-    if (TA0CCTL0 & COV) {       // If there has been an overflow, reset it
-        TA0CCTL0 &= ~COV;
+    // After a watchdog reset, carry on from the saved state
+    if ((IFG1 & WDTIFG) && saved.check == check(RESUME_MAGIC, &saved.r, sizeof(saved.r))) {
+        r = saved.r;
+        resumed = 1;
     }
+    IFG1 &= ~WDTIFG;
 
-    capture = count + c;
-    countadd = 0x10000 - c;     // count value for next counter overflow is the remainder of this cycle's count
+    config(resumed ? r.duty : PWM_START);
 
-    count = 0;
-    pps++;                      // 1pps counter
+    printfs("PID2-reorg-0703"); nl();
 
-#if USELED
-    if (bcg && (--bcg == 0)) {
-        P1OUT ^= 0x40;          // toggle green LED
-	if (P1OUT & 0x40) {     // off time is 1 second
-    	    bcg = blink_green;
-        } else {
-            bcg = 1;
-        }
+    if (resumed) {
+        printfs("** watchdog reset, resuming ");
+        printfd(r.state);
+        nl();
+        control_resume(&r);
+    } else {
+        control_init(PWM_START);
     }
 
-    if (bcy && --bcy == 0) {
-        P1OUT ^= 0x80;          // toggle yellow LED
-        if(P1OUT & 0x80) {
-            bcy = blink_yellow;
-        } else {
-            bcy = 1;
-        }
-    }
+    capture = 0;
+    while (1) {
+        watchdog_clear();
+        control_poll();
+        led_poll();
+#if COMMANDS
+        command_poll();
 #endif
 
+        // Look for a 1PPS signal
+        if (capture != 0) { // && state > GOOD
+            long c = capture;
+            capture = 0;
+            control_pps(c);
+#if COMPARE_INPUT
+            cmp_report();
+#endif
+            control_save(&saved.r);
+            saved.check = check(RESUME_MAGIC, &saved.r, sizeof(saved.r));
+#ifdef ISR_STATS
+            if (++seconds >= ISR_REPORT) {
+                seconds = 0;
+                isr_report();
+            }
+#endif
+#if PPS_OUT
+            if (++ppsseconds >= PPS_REPORT) {
+                ppsseconds = 0;
+                ppsout_report();
+            }
+#endif
+#if PPS_VALIDATE
+            if (++validseconds >= VALID_REPORT) {
+                validseconds = 0;
+                pps_report();
+            }
+#endif
+#if AUTO_BANDWIDTH
+            if (++jitterseconds >= JITTER_REPORT) {
+                jitterseconds = 0;
+                jitter_report();
+            }
+#endif
+        }
+    }
 }
-// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 
 
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 
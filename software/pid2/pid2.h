@@ -0,0 +1,236 @@
+/*
+ * pid2.h - Proportional + Integral Control for a GPS Disciplined Oscillator
+ *
+ * Copyright 2014-2017 Glen Overby
+ * 
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PID2_H
+#define PID2_H
+
+//#define DEBUG_SECOND
+#define DEBUG_SEC_SHORT
+//#define DEBUG
+#define DEBUG_PID
+
+/* Controller constants */
+
+/*
+ * P_FACTOR_FAST was calculated by using a binary search to find frequencies.
+ * Slow is 1/20th of that.
+ *
+ * The constants for each oscillator are in a header of their own
+ * (isotemp.h, fox801.h).  Build with -DOSC_PROFILE='"fox801.h"' for another.
+ */
+#ifndef OSC_PROFILE
+#define OSC_PROFILE     "isotemp.h"
+#endif
+#include OSC_PROFILE
+
+#define PWM_START       1       // PWM duty cycle at power on
+#define SAMPLE_SECONDS  8
+#define SAMPLE_MINUTE	60
+#define ERROR_CLEAR     5       // 1PPS seconds an error must be gone before its state is left
+
+// Seconds of count to skip after an adjustment, as the PWM filter settles.
+// The dual PWM's filter, and the SPI DAC's, settle within the second the
+// adjustment is made in, at its start.
+#if DUAL_PWM || SPI_DAC
+#define PWM_SETTLE      0
+#else
+#define PWM_SETTLE      1
+#endif
+
+/* Outlier filter for the per-second counts */
+#ifndef CAPTURE_FILTER
+#define CAPTURE_FILTER  1
+#endif
+#define FILTER_SIZE     5       // seconds of history
+#define FILTER_MADS     5       // outlier: further from the median than this many MADs
+#define FILTER_MIN      20      //   or this many counts, whichever is larger
+#define FILTER_CLAMP    3000    // offsets from 10mhz are clamped to this
+// The filter's deviations, up to twice the clamp, and its limit, up to
+// FILTER_MADS of them, are worked out in 16 bits
+#if FILTER_CLAMP * 2L * FILTER_MADS > 32767
+#error "FILTER_CLAMP is too large for the outlier filter's arithmetic"
+#endif
+
+/*
+ * Least squares frequency for FAST.  Rather than the count over the window,
+ * which is the difference of its first and last 1PPS timestamps, FAST's
+ * error is the slope of the line fitted to the phase at every second of the
+ * window (an omega counter), which averages out the timestamps' noise.  The
+ * sums are kept as the seconds come in.  The seconds' offsets are clamped
+ * to LSQ_CLAMP, which keeps the sums of a 200 second window within 32 bits;
+ * a larger offset is past FAST's largest step anyway.
+ */
+#ifndef FAST_LSQ
+#define FAST_LSQ        0
+#endif
+#define LSQ_CLAMP       250     // counts a second
+
+/*
+ * Auto-tuning.  Once FAST has locked, the duty cycle is stepped TUNE_STEP
+ * above and below the locked value and the frequency counted at each to
+ * measure the oscillator's Hz per PWM step, from which the gains are
+ * derived.  The gains are kept in flash and used from then on.
+ */
+#ifndef AUTOTUNE
+#define AUTOTUNE        0
+#endif
+#define TUNE_STEP       8192    // PWM steps either side of the locked duty cycle
+#define TUNE_SECONDS    16      // seconds at each step; the last SAMPLE_SECONDS are counted
+#define TUNE_BAND       2       // settled: within this many counts of the final rate
+#define TUNE_TRIES      3       // identifications to try before using the defaults
+#define TUNE_P_SLOW_DIV 50      // P_FACTOR_SLOW is P_FACTOR_FAST / this (as isotemp.h)
+#define TUNE_I_SLOW_DIV 100     // I_FACTOR_SLOW is P_FACTOR_FAST / this
+
+/*
+ * Command interface.  Lines received on the serial input (P2.4) read and
+ * set the gains, error bands and sample windows, force a state, report
+ * statistics and save the settings to flash (command.c).
+ */
+#ifndef COMMANDS
+#define COMMANDS        0
+#endif
+#define COMMAND_LINE    32      // longest command line
+
+// The gains are kept in variables (struct tune) rather than constants
+#define TUNABLE         (AUTOTUNE || COMMANDS)
+
+/*
+ * Phase lock.  Once SLOW has gone PLL_LOCK windows without an adjustment,
+ * it steers the oscillator's phase against the GPS 1PPS each second rather
+ * than its frequency over the window: a type 2 loop of natural frequency
+ * 1 / PLL_TAU radians a second and damping PLL_DAMPING hundredths, whose
+ * gains come from P_FACTOR_FAST, the PWM steps per Hz.  The phase starts at
+ * 0 and the loop's integral at the duty cycle SLOW locked at, so taking
+ * over doesn't move the oscillator.  A phase error of over PLL_MAX_PHASE
+ * counts hands back to SLOW.  The loop's tau is held to P_FACTOR_FAST <<
+ * (PLL_FRAC - PLL_I_BITS), 640000 seconds for the isotemp, so its integral
+ * gain isn't lost to rounding.
+ */
+#ifndef PLL
+#define PLL             0
+#endif
+#ifndef PLL_TAU
+#define PLL_TAU         300     // seconds
+#endif
+#ifndef PLL_DAMPING
+#define PLL_DAMPING     70      // hundredths
+#endif
+#define PLL_LOCK        2       // SLOW windows without an adjustment
+#define PLL_MAX_PHASE   1000    // counts, 100us
+#define PLL_FRAC        12      // fraction bits of the gains and integral
+#define PLL_I_BITS      4       // least bits of the integral gain, times tau
+
+/*
+ * Loop bandwidth from the 1PPS jitter.  In SLOW, the change in each
+ * second's count from the last is the difference of three timestamps'
+ * errors, so its mean square is 6 times the variance of one: the 1PPS's
+ * jitter and the counter's quantization.  The square is averaged over about
+ * 2^JITTER_SHIFT seconds.  Each SLOW window is SAMPLE_MINUTE times 1 more
+ * than the rms jitter over JITTER_STEP, up to BW_MAX (and 200 seconds),
+ * with the P gain divided by the same so it acts on the same frequency
+ * error, and the PLL's tau multiplied by it.
+ */
+#ifndef AUTO_BANDWIDTH
+#define AUTO_BANDWIDTH  0
+#endif
+#define JITTER_SHIFT    8       // averaging, 256 seconds
+#define JITTER_FRAC     8       // fraction bits of the mean square (as jitter_ns())
+#define JITTER_CLAMP    100     // counts of change a second
+#ifndef JITTER_STEP
+#define JITTER_STEP     50      // ns rms
+#endif
+#define BW_MAX          3       // SAMPLE_MINUTEs in a window
+
+//#define DEBUG_SECOND  1
+
+// State Machine
+#define START       0
+#define CHECKERRORS 1
+#define OSCCOLD     2
+#define NOOSCCLOCK  3
+#define NOGPSPPS    4
+#define NOGPSLOCK   5
+#define GOOD        6
+// Below states run only on 1PPS clock
+#define FASTINIT    7
+#define FASTWAIT    8
+#define FAST        9
+#define SLOWINIT    10
+#define SLOW        11
+#define TUNE        12
+
+#include <stdint.h>
+
+extern char state;
+#if CAPTURE_FILTER
+extern uint16_t outliers;
+#endif
+
+#if TUNABLE
+// Gains in use: found by auto-tuning, or set by command
+struct tune {
+    int16_t p_fast;             // P_FACTOR_FAST
+    int16_t max_error;          // P_MAX_ERROR
+    int16_t p_slow;             // P_FACTOR_SLOW
+    int16_t i_slow;             // I_FACTOR_SLOW
+    int16_t settle;             // seconds to skip after a FAST adjustment
+    int16_t p_band;             // P_ERRORBAND_SLOW
+    int16_t i_band;             // I_ERRORBAND_SLOW
+    int16_t fast_seconds;       // SAMPLE_SECONDS
+    int16_t slow_seconds;       // SAMPLE_MINUTE
+#if PLL
+    int16_t pll_tau;            // PLL_TAU
+    int16_t pll_damping;        // PLL_DAMPING
+#endif
+};
+
+extern struct tune tune;
+#endif
+
+// Controller state kept over a watchdog reset
+struct resume {
+    uint16_t duty;              // PWM duty cycle
+    int16_t Ihist;              // SLOW's integral history
+    char state;
+};
+
+// Control state machine (control.c)
+void control_init (uint16_t duty);
+void control_poll (void);
+int control_pps (int32_t c);
+void control_save (struct resume *r);
+void control_resume (const struct resume *r);
+int control_force (char s);
+#if AUTO_BANDWIDTH
+void jitter_report (void);
+#endif
+
+// Command interface (command.c)
+void command_poll (void);
+
+// Board interface (main.c)
+void ledstate (int blue, int green, int yellow);
+int osc_cold (void);
+int gps_nolock (void);
+#if TUNABLE
+int tune_load (struct tune *t);
+void tune_save (const struct tune *t);
+#endif
+
+#endif /* PID2_H */
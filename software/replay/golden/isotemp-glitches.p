@@ -0,0 +1,479 @@
+20 *05F5E0CE 50 8EA6 3750    
+35 *05F5E0FF 1 8EA7 1    
+50 *05F5E100 0 8EA7 0    
+65 *05F5E100 0 8EA7 0    
+80 *05F5E101 -1 8EA6 -1    
+95 *05F5E100 0 8EA6 0    
+110 *05F5E100 0 8EA6 0    
+125 *05F5E100 0 8EA6 0    
+140 *05F5E0FF 1 8EA7 1    
+155 *05F5E100 0 8EA7 0    
+170 *05F5E100 0 8EA7 0    
+185 *05F5E100 0 8EA7 0    
+200 *05F5E100 0 8EA7 0    
+215 *05F5E101 -1 8EA6 -1    
+230 *05F5E100 0 8EA6 0    
+245 *05F5E101 -1 8EA5 -1    
+260 *05F5E100 0 8EA5 0    
+275 *05F5E100 0 8EA5 0    
+290 *05F5E100 0 8EA5 0    
+305 *068E7780 -10000000 7725 -6016    
+320 *05F5E101 -1 7724 -1    
+335 *05F5E100 0 7724 0    
+350 *05F5E101 -1 7723 -1    
+365 *05F5E100 0 7723 0    
+380 *05F5E100 0 7723 0    
+395 *05F5E100 0 7723 0    
+410 *05F5E100 0 7723 0    
+425 *05F5E100 0 7723 0    
+440 *05F5E100 0 7723 0    
+455 *05F5E100 0 7723 0    
+470 *05F5E100 0 7723 0    
+485 *05F5E100 0 7723 0    
+500 *05F5E100 0 7723 0    
+515 *05F5E100 0 7723 0    
+530 *05F5E100 0 7723 0    
+545 *05F5E100 0 7723 0    
+560 *05F5E100 0 7723 0    
+575 *05F5E100 0 7723 0    
+590 *05F5E100 0 7723 0    
+605 *055D4A80 10000000 8EA3 6016    
+620 *05F5E100 0 8EA3 0    
+635 *05F5E100 0 8EA3 0    
+650 *05F5E100 0 8EA3 0    
+665 *05F5E0FF 1 8EA4 1    
+680 *05F5E100 0 8EA4 0    
+695 *05F5E100 0 8EA4 0    
+710 *05F5E101 -1 8EA3 -1    
+725 *05F5E100 0 8EA3 0    
+740 *05F5E100 0 8EA3 0    
+755 *05F5E101 -1 8EA2 -1    
+770 *05F5E101 -1 8EA1 -1    
+785 *05F5E100 0 8EA1 0    
+800 *05F5E100 0 8EA1 0    
+815 *05F5E100 0 8EA1 0    
+830 *05F5E100 0 8EA1 0    
+845 *05F5E0FF 1 8EA2 1    
+860 *05F5E100 0 8EA2 0    
+875 *05F5E101 -1 8EA1 -1    
+890 *05F5E101 -1 8EA0 -1    
+905 *05F5E100 0 8EA0 0    
+920 *05F5E100 0 8EA0 0    
+935 *05F5E0FF 1 8EA1 1    
+950 *05F5E0FF 1 8EA2 1    
+965 *05F5E100 0 8EA2 0    
+980 *05F5E100 0 8EA2 0    
+995 *05F5E100 0 8EA2 0    
+1010 *05F5E101 -1 8EA1 -1    
+1025 *05F5E101 -1 8EA0 -1    
+1040 *05F5E100 0 8EA0 0    
+1055 *05F5E100 0 8EA0 0    
+1070 *05F5E100 0 8EA0 0    
+1085 *05F5E0FF 1 8EA1 1    
+1100 *05F5E100 0 8EA1 0    
+1115 *05F5E0FF 1 8EA2 1    
+1130 *05F5E100 0 8EA2 0    
+1145 *05F5E100 0 8EA2 0    
+1160 *05F5E100 0 8EA2 0    
+1175 *05F5E100 0 8EA2 0    
+1190 *05F5E100 0 8EA2 0    
+1205 *068E7780 -10000000 7722 -6016    
+1220 *05F5E100 0 7722 0    
+1235 *05F5E100 0 7722 0    
+1250 *05F5E100 0 7722 0    
+1265 *05F5E100 0 7722 0    
+1280 *05F5E100 0 7722 0    
+1295 *05F5E100 0 7722 0    
+1310 *05F5E100 0 7722 0    
+1325 *05F5E100 0 7722 0    
+1340 *05F5E100 0 7722 0    
+1355 *05F5E100 0 7722 0    
+1370 *05F5E0FF 1 7723 1    
+1385 *05F5E100 0 7723 0    
+1400 *05F5E100 0 7723 0    
+1415 *05F5E100 0 7723 0    
+1430 *05F5E100 0 7723 0    
+1445 *05F5E100 0 7723 0    
+1460 *05F5E0FF 1 7724 1    
+1475 *05F5E0FF 1 7725 1    
+1490 *05F5E100 0 7725 0    
+1505 *055D4A80 10000000 8EA5 6016    
+1520 *05F5E101 -1 8EA4 -1    
+1535 *05F5E100 0 8EA4 0    
+1550 *05F5E0FF 1 8EA5 1    
+1565 *05F5E100 0 8EA5 0    
+1580 *05F5E100 0 8EA5 0    
+1595 *05F5E0FF 1 8EA6 1    
+1610 *05F5E100 0 8EA6 0    
+1625 *05F5E100 0 8EA6 0    
+1640 *05F5E100 0 8EA6 0    
+1655 *05F5E0FF 1 8EA7 1    
+1670 *05F5E100 0 8EA7 0    
+1685 *05F5E100 0 8EA7 0    
+1700 *05F5E100 0 8EA7 0    
+1715 *05F5E100 0 8EA7 0    
+1730 *05F5E100 0 8EA7 0    
+1745 *05F5E100 0 8EA7 0    
+1760 *05F5E100 0 8EA7 0    
+1775 *05F5E100 0 8EA7 0    
+1790 *05F5E100 0 8EA7 0    
+1805 *05F5E100 0 8EA7 0    
+1820 *05F5E100 0 8EA7 0    
+1835 *05F5E100 0 8EA7 0    
+1850 *05F5E100 0 8EA7 0    
+1865 *05F5E100 0 8EA7 0    
+1880 *05F5E100 0 8EA7 0    
+1895 *05F5E100 0 8EA7 0    
+1910 *05F5E100 0 8EA7 0    
+1925 *05F5E100 0 8EA7 0    
+1940 *05F5E100 0 8EA7 0    
+1955 *05F5E100 0 8EA7 0    
+1970 *05F5E100 0 8EA7 0    
+1985 *05F5E100 0 8EA7 0    
+2000 *05F5E100 0 8EA7 0    
+2015 *05F5E100 0 8EA7 0    
+2030 *05F5E100 0 8EA7 0    
+2045 *05F5E100 0 8EA7 0    
+2060 *05F5E0FF 1 8EA8 1    
+2075 *05F5E100 0 8EA8 0    
+2090 *05F5E101 -1 8EA7 -1    
+2105 *068E7781 -10000001 76DC -6091    
+2120 *05F5E100 0 76DC 0    
+2135 *05F5E100 0 76DC 0    
+2150 *05F5E100 0 76DC 0    
+2165 *05F5E101 -1 76DB -1    
+2180 *05F5E100 0 76DB 0    
+2195 *05F5E101 -1 76DA -1    
+2210 *05F5E0FF 1 76DB 1    
+2225 *05F5E100 0 76DB 0    
+2240 *05F5E100 0 76DB 0    
+2255 *05F5E100 0 76DB 0    
+2270 *05F5E100 0 76DB 0    
+2285 *05F5E100 0 76DB 0    
+2300 *05F5E100 0 76DB 0    
+2315 *05F5E100 0 76DB 0    
+2330 *05F5E100 0 76DB 0    
+2345 *05F5E100 0 76DB 0    
+2360 *05F5E100 0 76DB 0    
+2375 *05F5E0FF 1 76DC 1    
+2390 *05F5E100 0 76DC 0    
+2405 *055D4A80 10000000 8E5C 6016    
+2420 *05F5E100 0 8E5C 0    
+2435 *05F5E100 0 8E5C 0    
+2450 *05F5E100 0 8E5C 0    
+2465 *05F5E100 0 8E5C 0    
+2480 *05F5E100 0 8E5C 0    
+2495 *05F5E100 0 8E5C 0    
+2510 *05F5E101 -1 8E5B -1    
+2525 *05F5E100 0 8E5B 0    
+2540 *05F5E100 0 8E5B 0    
+2555 *05F5E100 0 8E5B 0    
+2570 *05F5E101 -1 8E5A -1    
+2585 *05F5E101 -1 8E59 -1    
+2600 *05F5E100 0 8E59 0    
+2615 *05F5E101 -1 8E58 -1    
+2630 *05F5E100 0 8E58 0    
+2645 *05F5E100 0 8E58 0    
+2660 *05F5E100 0 8E58 0    
+2675 *05F5E100 0 8E58 0    
+2690 *05F5E100 0 8E58 0    
+2705 *05F5E100 0 8E58 0    
+2720 *05F5E100 0 8E58 0    
+2735 *05F5E100 0 8E58 0    
+2750 *05F5E100 0 8E58 0    
+2765 *05F5E100 0 8E58 0    
+2780 *05F5E100 0 8E58 0    
+2795 *05F5E100 0 8E58 0    
+2810 *05F5E100 0 8E58 0    
+2825 *05F5E100 0 8E58 0    
+2840 *05F5E100 0 8E58 0    
+2855 *05F5E100 0 8E58 0    
+2870 *05F5E100 0 8E58 0    
+2885 *05F5E100 0 8E58 0    
+2900 *05F5E100 0 8E58 0    
+2915 *05F5E100 0 8E58 0    
+2930 *05F5E101 -1 8E57 -1    
+2945 *05F5E100 0 8E57 0    
+2960 *05F5E100 0 8E57 0    
+2975 *05F5E0FF 1 8E58 1    
+2990 *05F5E100 0 8E58 0    
+3005 *068E7780 -10000000 76D8 -6016    
+3020 *05F5E0FF 1 76D9 1    
+3035 *05F5E101 -1 76D8 -1    
+3050 *05F5E100 0 76D8 0    
+3065 *05F5E100 0 76D8 0    
+3080 *05F5E100 0 76D8 0    
+3095 *05F5E0FF 1 76D9 1    
+3110 *05F5E100 0 76D9 0    
+3125 *05F5E100 0 76D9 0    
+3140 *05F5E100 0 76D9 0    
+3155 *05F5E100 0 76D9 0    
+3170 *05F5E100 0 76D9 0    
+3185 *05F5E100 0 76D9 0    
+3200 *05F5E100 0 76D9 0    
+3215 *05F5E100 0 76D9 0    
+3230 *05F5E100 0 76D9 0    
+3245 *05F5E100 0 76D9 0    
+3260 *05F5E100 0 76D9 0    
+3275 *05F5E101 -1 76D8 -1    
+3290 *05F5E0FF 1 76D9 1    
+3305 *055D4A80 10000000 8E59 6016    
+3320 *05F5E100 0 8E59 0    
+3335 *05F5E0FF 1 8E5A 1    
+3350 *05F5E101 -1 8E59 -1    
+3365 *05F5E100 0 8E59 0    
+3380 *05F5E0FF 1 8E5A 1    
+3395 *05F5E100 0 8E5A 0    
+3410 *05F5E100 0 8E5A 0    
+3425 *05F5E100 0 8E5A 0    
+3440 *05F5E100 0 8E5A 0    
+3455 *05F5E100 0 8E5A 0    
+3470 *05F5E100 0 8E5A 0    
+3485 *05F5E100 0 8E5A 0    
+3500 *05F5E100 0 8E5A 0    
+3515 *05F5E100 0 8E5A 0    
+3530 *05F5E100 0 8E5A 0    
+3545 *05F5E100 0 8E5A 0    
+3560 *05F5E100 0 8E5A 0    
+3575 *05F5E100 0 8E5A 0    
+3590 *05F5E100 0 8E5A 0    
+3605 *05F5E0FF 1 8E5B 1    
+3620 *05F5E100 0 8E5B 0    
+3635 *05F5E100 0 8E5B 0    
+3650 *05F5E100 0 8E5B 0    
+3665 *05F5E0FF 1 8E5C 1    
+3680 *05F5E100 0 8E5C 0    
+3695 *05F5E100 0 8E5C 0    
+3710 *05F5E100 0 8E5C 0    
+3725 *05F5E100 0 8E5C 0    
+3740 *05F5E100 0 8E5C 0    
+3755 *05F5E100 0 8E5C 0    
+3770 *05F5E100 0 8E5C 0    
+3785 *05F5E100 0 8E5C 0    
+3800 *05F5E100 0 8E5C 0    
+3815 *05F5E0FF 1 8E5D 1    
+3830 *05F5E100 0 8E5D 0    
+3845 *05F5E100 0 8E5D 0    
+3860 *05F5E100 0 8E5D 0    
+3875 *05F5E100 0 8E5D 0    
+3890 *05F5E0FF 1 8E5E 1    
+3905 *068E7780 -10000000 76DE -6016    
+3920 *05F5E100 0 76DE 0    
+3935 *05F5E100 0 76DE 0    
+3950 *05F5E101 -1 76DD -1    
+3965 *05F5E100 0 76DD 0    
+3980 *05F5E0FF 1 76DE 1    
+3995 *05F5E100 0 76DE 0    
+4010 *05F5E0FF 1 76DF 1    
+4025 *05F5E100 0 76DF 0    
+4040 *05F5E100 0 76DF 0    
+4055 *05F5E0FF 1 76E0 1    
+4070 *05F5E100 0 76E0 0    
+4085 *05F5E100 0 76E0 0    
+4100 *05F5E100 0 76E0 0    
+4115 *05F5E100 0 76E0 0    
+4130 *05F5E100 0 76E0 0    
+4145 *05F5E100 0 76E0 0    
+4160 *05F5E100 0 76E0 0    
+4175 *05F5E100 0 76E0 0    
+4190 *05F5E100 0 76E0 0    
+4205 *055D4A80 10000000 8E60 6016    
+4220 *05F5E100 0 8E60 0    
+4235 *05F5E100 0 8E60 0    
+4250 *05F5E100 0 8E60 0    
+4265 *05F5E100 0 8E60 0    
+4280 *05F5E0FF 1 8E61 1    
+4295 *05F5E100 0 8E61 0    
+4310 *05F5E0FF 1 8E62 1    
+4325 *05F5E100 0 8E62 0    
+4340 *05F5E101 -1 8E61 -1    
+4355 *05F5E100 0 8E61 0    
+4370 *05F5E100 0 8E61 0    
+4385 *05F5E100 0 8E61 0    
+4400 *05F5E100 0 8E61 0    
+4415 *05F5E100 0 8E61 0    
+4430 *05F5E100 0 8E61 0    
+4445 *05F5E100 0 8E61 0    
+4460 *05F5E100 0 8E61 0    
+4475 *05F5E100 0 8E61 0    
+4490 *05F5E100 0 8E61 0    
+4505 *05F5E100 0 8E61 0    
+4520 *05F5E100 0 8E61 0    
+4535 *05F5E100 0 8E61 0    
+4550 *05F5E100 0 8E61 0    
+4565 *05F5E100 0 8E61 0    
+4580 *05F5E100 0 8E61 0    
+4595 *05F5E100 0 8E61 0    
+4610 *05F5E100 0 8E61 0    
+4625 *05F5E101 -1 8E60 -1    
+4640 *05F5E100 0 8E60 0    
+4655 *05F5E0FF 1 8E61 1    
+4670 *05F5E100 0 8E61 0    
+4685 *05F5E0FF 1 8E62 1    
+4700 *05F5E100 0 8E62 0    
+4715 *05F5E0FF 1 8E63 1    
+4730 *05F5E100 0 8E63 0    
+4745 *05F5E100 0 8E63 0    
+4760 *05F5E100 0 8E63 0    
+4775 *05F5E100 0 8E63 0    
+4790 *05F5E100 0 8E63 0    
+4805 *068E7780 -10000000 76E3 -6016    
+4820 *05F5E100 0 76E3 0    
+4835 *05F5E100 0 76E3 0    
+4850 *05F5E101 -1 76E2 -1    
+4865 *05F5E100 0 76E2 0    
+4880 *05F5E100 0 76E2 0    
+4895 *05F5E100 0 76E2 0    
+4910 *05F5E100 0 76E2 0    
+4925 *05F5E100 0 76E2 0    
+4940 *05F5E0FF 1 76E3 1    
+4955 *05F5E0FF 1 76E4 1    
+4970 *05F5E0FF 1 76E5 1    
+4985 *05F5E0FF 1 76E6 1    
+5000 *05F5E100 0 76E6 0    
+5015 *05F5E100 0 76E6 0    
+5030 *05F5E100 0 76E6 0    
+5045 *05F5E100 0 76E6 0    
+5060 *05F5E100 0 76E6 0    
+5075 *05F5E100 0 76E6 0    
+5090 *05F5E0FF 1 76E7 1    
+5105 *055D4A80 10000000 8E67 6016    
+5120 *05F5E100 0 8E67 0    
+5135 *05F5E100 0 8E67 0    
+5150 *05F5E100 0 8E67 0    
+5165 *05F5E100 0 8E67 0    
+5180 *05F5E100 0 8E67 0    
+5195 *05F5E101 -1 8E66 -1    
+5210 *05F5E100 0 8E66 0    
+5225 *05F5E100 0 8E66 0    
+5240 *05F5E100 0 8E66 0    
+5255 *05F5E100 0 8E66 0    
+5270 *05F5E100 0 8E66 0    
+5285 *05F5E101 -1 8E65 -1    
+5300 *05F5E101 -1 8E64 -1    
+5315 *05F5E101 -1 8E63 -1    
+5330 *05F5E0FF 1 8E64 1    
+5345 *05F5E0FF 1 8E65 1    
+5360 *05F5E0FF 1 8E66 1    
+5375 *05F5E100 0 8E66 0    
+5390 *05F5E100 0 8E66 0    
+5405 *05F5E100 0 8E66 0    
+5420 *05F5E100 0 8E66 0    
+5435 *05F5E100 0 8E66 0    
+5450 *05F5E100 0 8E66 0    
+5465 *05F5E100 0 8E66 0    
+5480 *05F5E100 0 8E66 0    
+5495 *05F5E100 0 8E66 0    
+5510 *05F5E100 0 8E66 0    
+5525 *05F5E100 0 8E66 0    
+5540 *05F5E100 0 8E66 0    
+5555 *05F5E100 0 8E66 0    
+5570 *05F5E101 -1 8E65 -1    
+5585 *05F5E0FF 1 8E66 1    
+5600 *05F5E0FF 1 8E67 1    
+5615 *05F5E0FF 1 8E68 1    
+5630 *05F5E100 0 8E68 0    
+5645 *05F5E0FF 1 8E69 1    
+5660 *05F5E101 -1 8E68 -1    
+5675 *05F5E101 -1 8E67 -1    
+5690 *05F5E100 0 8E67 0    
+5705 *068E777F -9999999 7732 -5941    
+5720 *05F5E0FF 1 7733 1    
+5735 *05F5E100 0 7733 0    
+5750 *05F5E100 0 7733 0    
+5765 *05F5E100 0 7733 0    
+5780 *05F5E100 0 7733 0    
+5795 *05F5E100 0 7733 0    
+5810 *05F5E100 0 7733 0    
+5825 *05F5E100 0 7733 0    
+5840 *05F5E100 0 7733 0    
+5855 *05F5E100 0 7733 0    
+5870 *05F5E100 0 7733 0    
+5885 *05F5E100 0 7733 0    
+5900 *05F5E101 -1 7732 -1    
+5915 *05F5E100 0 7732 0    
+5930 *05F5E100 0 7732 0    
+5945 *05F5E101 -1 7731 -1    
+5960 *05F5E0FF 1 7732 1    
+5975 *05F5E0FF 1 7733 1    
+5990 *05F5E101 -1 7732 -1    
+6005 *055D4A80 10000000 8EB2 6016    
+6020 *05F5E101 -1 8EB1 -1    
+6035 *05F5E101 -1 8EB0 -1    
+6050 *05F5E100 0 8EB0 0    
+6065 *05F5E100 0 8EB0 0    
+6080 *05F5E100 0 8EB0 0    
+6095 *05F5E100 0 8EB0 0    
+6110 *05F5E100 0 8EB0 0    
+6125 *05F5E100 0 8EB0 0    
+6140 *05F5E100 0 8EB0 0    
+6155 *05F5E100 0 8EB0 0    
+6170 *05F5E100 0 8EB0 0    
+6185 *05F5E100 0 8EB0 0    
+6200 *05F5E100 0 8EB0 0    
+6215 *05F5E100 0 8EB0 0    
+6230 *05F5E100 0 8EB0 0    
+6245 *05F5E0FF 1 8EB1 1    
+6260 *05F5E100 0 8EB1 0    
+6275 *05F5E100 0 8EB1 0    
+6290 *05F5E100 0 8EB1 0    
+6305 *05F5E100 0 8EB1 0    
+6320 *05F5E100 0 8EB1 0    
+6335 *05F5E100 0 8EB1 0    
+6350 *05F5E101 -1 8EB0 -1    
+6365 *05F5E100 0 8EB0 0    
+6380 *05F5E100 0 8EB0 0    
+6395 *05F5E100 0 8EB0 0    
+6410 *05F5E100 0 8EB0 0    
+6425 *05F5E0FF 1 8EB1 1    
+6440 *05F5E100 0 8EB1 0    
+6455 *05F5E100 0 8EB1 0    
+6470 *05F5E100 0 8EB1 0    
+6485 *05F5E100 0 8EB1 0    
+6500 *05F5E100 0 8EB1 0    
+6515 *05F5E100 0 8EB1 0    
+6530 *05F5E101 -1 8EB0 -1    
+6545 *05F5E100 0 8EB0 0    
+6560 *05F5E100 0 8EB0 0    
+6575 *05F5E0FF 1 8EB1 1    
+6590 *05F5E100 0 8EB1 0    
+6605 *068E7780 -10000000 7731 -6016    
+6620 *05F5E0FF 1 7732 1    
+6635 *05F5E100 0 7732 0    
+6650 *05F5E101 -1 7731 -1    
+6665 *05F5E101 -1 7730 -1    
+6680 *05F5E0FF 1 7731 1    
+6695 *05F5E0FF 1 7732 1    
+6710 *05F5E100 0 7732 0    
+6725 *05F5E100 0 7732 0    
+6740 *05F5E100 0 7732 0    
+6755 *05F5E0FF 1 7733 1    
+6770 *05F5E100 0 7733 0    
+6785 *05F5E100 0 7733 0    
+6800 *05F5E100 0 7733 0    
+6815 *05F5E100 0 7733 0    
+6830 *05F5E100 0 7733 0    
+6845 *05F5E100 0 7733 0    
+6860 *05F5E100 0 7733 0    
+6875 *05F5E100 0 7733 0    
+6890 *05F5E0FF 1 7734 1    
+6905 *055D4A7F 10000001 8EFF 6091    
+6920 *05F5E100 0 8EFF 0    
+6935 *05F5E0FF 1 8F00 1    
+6950 *05F5E100 0 8F00 0    
+6965 *05F5E100 0 8F00 0    
+6980 *05F5E0FF 1 8F01 1    
+6995 *05F5E100 0 8F01 0    
+7010 *05F5E0FF 1 8F02 1    
+7025 *05F5E101 -1 8F01 -1    
+7040 *05F5E100 0 8F01 0    
+7055 *05F5E100 0 8F01 0    
+7070 *05F5E100 0 8F01 0    
+7085 *05F5E100 0 8F01 0    
+7100 *05F5E100 0 8F01 0    
+7115 *05F5E100 0 8F01 0    
+7130 *05F5E100 0 8F01 0    
+7145 *05F5E100 0 8F01 0    
+7160 *05F5E100 0 8F01 0    
+7175 *05F5E100 0 8F01 0    
+7190 *05F5E100 0 8F01 0    
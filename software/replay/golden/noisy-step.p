@@ -0,0 +1,479 @@
+20 *05F5E140 -64 6D40 -4800    
+35 *05F5E100 0 6D40 0    
+50 *05F5E101 -1 6D3F -1    
+65 *05F5E102 -2 6D2B -20    
+80 *05F5E101 -1 6D2A -1    
+95 *05F5E101 -1 6D29 -1    
+110 *05F5E0FE 2 6D3D 20    
+125 *05F5E101 -1 6D3C -1    
+140 *05F5E101 -1 6D3B -1    
+155 *05F5E0FF 1 6D3C 1    
+170 *05F5E100 0 6D3C 0    
+185 *05F5E104 -4 6C10 -300    
+200 *05F5E0FE 2 6C24 20    
+215 *05F5E0FD 3 6D05 225    
+230 *05F5E0FC 4 6E31 300    
+245 *05F5E100 0 6E31 0    
+260 *05F5E104 -4 6D05 -300    
+275 *05F5E0FD 3 6DE6 225    
+290 *05F5E102 -2 6DD2 -20    
+305 *05F5E100 0 6DD2 0    
+320 *05F5E100 0 6DD2 0    
+335 *05F5E0FF 1 6DD3 1    
+350 *05F5E102 -2 6DBF -20    
+365 *05F5E0FF 1 6DC0 1    
+380 *05F5E102 -2 6DAC -20    
+395 *05F5E102 -2 6D98 -20    
+410 *05F5E101 -1 6D97 -1    
+425 *05F5E102 -2 6D83 -20    
+440 *05F5E0FE 2 6D97 20    
+455 *05F5E102 -2 6D83 -20    
+470 *05F5E103 -3 6CA2 -225    
+485 *05F5E0FF 1 6CA3 1    
+500 *05F5E101 -1 6CA2 -1    
+515 *05F5E100 0 6CA2 0    
+530 *05F5E100 0 6CA2 0    
+545 *05F5E100 0 6CA2 0    
+560 *05F5E102 -2 6C8E -20    
+575 *05F5E0FF 1 6C8F 1    
+590 *05F5E0FF 1 6C90 1    
+605 *05F5E102 -2 6C7C -20    
+620 *05F5E0FE 2 6C90 20    
+635 *05F5E0FE 2 6CA4 20    
+650 *05F5E0FE 2 6CB8 20    
+665 *05F5E102 -2 6CA4 -20    
+680 *05F5E101 -1 6CA3 -1    
+695 *05F5E0FB 5 6E1A 375    
+710 *05F5E100 0 6E1A 0    
+725 *05F5E104 -4 6CEE -300    
+740 *05F5E0FF 1 6CEF 1    
+755 *05F5E102 -2 6CDB -20    
+770 *05F5E100 0 6CDB 0    
+785 *05F5E100 0 6CDB 0    
+800 *05F5E100 0 6CDB 0    
+815 *05F5E102 -2 6CC7 -20    
+830 *05F5E0FF 1 6CC8 1    
+845 *05F5E0FC 4 6DF4 300    
+860 *05F5E0FF 1 6DF5 1    
+875 *05F5E0FF 1 6DF6 1    
+890 *05F5E101 -1 6DF5 -1    
+905 *05F5E102 -2 6DE1 -20    
+920 *05F5E101 -1 6DE0 -1    
+935 *05F5E101 -1 6DDF -1    
+950 *05F5E100 0 6DDF 0    
+965 *05F5E0FF 1 6DE0 1    
+980 *05F5E0FF 1 6DE1 1    
+995 *05F5E0FF 1 6DE2 1    
+1010 *05F5E100 0 6DE2 0    
+1025 *05F5E0FF 1 6DE3 1    
+1040 *05F5E0FE 2 6DF7 20    
+1055 *05F5E0FE 2 6E0B 20    
+1070 *05F5E103 -3 6D2A -225    
+1085 *05F5E101 -1 6D29 -1    
+1100 *05F5E101 -1 6D28 -1    
+1115 *05F5E0FF 1 6D29 1    
+1130 *05F5E101 -1 6D28 -1    
+1145 *05F5E0FF 1 6D29 1    
+1160 *05F5E102 -2 6D15 -20    
+1175 *05F5E100 0 6D15 0    
+1190 *05F5E0FF 1 6D16 1    
+1205 *05F5E100 0 6D16 0    
+1220 *05F5E100 0 6D16 0    
+1235 *05F5E0FF 1 6D17 1    
+1250 *05F5E100 0 6D17 0    
+1265 *05F5E100 0 6D17 0    
+1280 *05F5E101 -1 6D16 -1    
+1295 *05F5E0FF 1 6D17 1    
+1310 *05F5E100 0 6D17 0    
+1325 *05F5E100 0 6D17 0    
+1340 *05F5E102 -2 6D03 -20    
+1355 *05F5E0FF 1 6D04 1    
+1370 *05F5E100 0 6D04 0    
+1385 *05F5E105 -5 6B8D -375    
+1400 *05F5E101 -1 6B8C -1    
+1415 *05F5E0FE 2 6BA0 20    
+1430 *05F5E0FF 1 6BA1 1    
+1445 *05F5E100 0 6BA1 0    
+1460 *05F5E101 -1 6BA0 -1    
+1475 *05F5E0FD 3 6C81 225    
+1490 *05F5E100 0 6C81 0    
+1505 *05F5E101 -1 6C80 -1    
+1520 *05F5E0FE 2 6C94 20    
+1535 *05F5E0FE 2 6CA8 20    
+1550 *05F5E102 -2 6C94 -20    
+1565 *05F5E101 -1 6C93 -1    
+1580 *05F5E100 0 6C93 0    
+1595 *05F5E102 -2 6C7F -20    
+1610 *05F5E101 -1 6C7E -1    
+1625 *05F5E100 0 6C7E 0    
+1640 *05F5E101 -1 6C7D -1    
+1655 *05F5E100 0 6C7D 0    
+1670 *05F5E0FF 1 6C7E 1    
+1685 *05F5E101 -1 6C7D -1    
+1700 *05F5E0FF 1 6C7E 1    
+1715 *05F5E100 0 6C7E 0    
+1730 *05F5E100 0 6C7E 0    
+1745 *05F5E100 0 6C7E 0    
+1760 *05F5E102 -2 6C6A -20    
+1775 *05F5E103 -3 6B89 -225    
+1790 *05F5E102 -2 6B75 -20    
+1805 *05F5E100 0 6B75 0    
+1820 *05F5E0FF 1 6B76 1    
+1835 *05F5E101 -1 6B75 -1    
+1850 *05F5E100 0 6B75 0    
+1865 *05F5E101 -1 6B74 -1    
+1880 *05F5E0FF 1 6B75 1    
+1895 *05F5E101 -1 6B74 -1    
+1910 *05F5E103 -3 6A93 -225    
+1925 *05F5E0FF 1 6A94 1    
+1940 *05F5E101 -1 6A93 -1    
+1955 *05F5E101 -1 6A92 -1    
+1970 *05F5E0FC 4 6BBE 300    
+1985 *05F5E101 -1 6BBD -1    
+2000 *05F5E101 -1 6BBC -1    
+2015 *05F5E100 0 6BBC 0    
+2030 *05F5E102 -2 6BA8 -20    
+2045 *05F5E101 -1 6BA7 -1    
+2060 *05F5E100 0 6BA7 0    
+2075 *05F5E0FF 1 6BA8 1    
+2090 *05F5E0FF 1 6BA9 1    
+2105 *05F5E100 0 6BA9 0    
+2120 *05F5E101 -1 6BA8 -1    
+2135 *05F5E101 -1 6BA7 -1    
+2150 *05F5E102 -2 6B93 -20    
+2165 *05F5E100 0 6B93 0    
+2180 *05F5E100 0 6B93 0    
+2195 *05F5E100 0 6B93 0    
+2210 *05F5E0FF 1 6B94 1    
+2225 *05F5E102 -2 6B80 -20    
+2240 *05F5E101 -1 6B7F -1    
+2255 *05F5E102 -2 6B6B -20    
+2270 *05F5E0FF 1 6B6C 1    
+2285 *05F5E103 -3 6A8B -225    
+2300 *05F5E0FF 1 6A8C 1    
+2315 *05F5E0FF 1 6A8D 1    
+2330 *05F5E102 -2 6A79 -20    
+2345 *05F5E0FF 1 6A7A 1    
+2360 *05F5E104 -4 694E -300    
+2375 *05F5E0FF 1 694F 1    
+2390 *05F5E100 0 694F 0    
+2405 *05F5E0FC 4 6A7B 300    
+2420 *05F5E0FD 3 6B5C 225    
+2435 *05F5E102 -2 6B48 -20    
+2450 *05F5E101 -1 6B47 -1    
+2465 *05F5E100 0 6B47 0    
+2480 *05F5E101 -1 6B46 -1    
+2495 *05F5E100 0 6B46 0    
+2510 *05F5E100 0 6B46 0    
+2525 *05F5E0FC 4 6C72 300    
+2540 *05F5E101 -1 6C71 -1    
+2555 *05F5E0FF 1 6C72 1    
+2570 *05F5E100 0 6C72 0    
+2585 *05F5E0FF 1 6C73 1    
+2600 *05F5E0FF 1 6C74 1    
+2615 *05F5E0FE 2 6C88 20    
+2630 *05F5E101 -1 6C87 -1    
+2645 *05F5E101 -1 6C86 -1    
+2660 *05F5E102 -2 6C72 -20    
+2675 *05F5E102 -2 6C5E -20    
+2690 *05F5E101 -1 6C5D -1    
+2705 *05F5E0FE 2 6C71 20    
+2720 *05F5E103 -3 6B90 -225    
+2735 *05F5E0FF 1 6B91 1    
+2750 *05F5E0FF 1 6B92 1    
+2765 *05F5E0FC 4 6CBE 300    
+2780 *05F5E102 -2 6CAA -20    
+2795 *05F5E102 -2 6C96 -20    
+2810 *05F5E0FF 1 6C97 1    
+2825 *05F5E0FF 1 6C98 1    
+2840 *05F5E102 -2 6C84 -20    
+2855 *05F5E100 0 6C84 0    
+2870 *05F5E0FE 2 6C98 20    
+2885 *05F5E100 0 6C98 0    
+2900 *05F5E0FE 2 6CAC 20    
+2915 *05F5E101 -1 6CAB -1    
+2930 *05F5E100 0 6CAB 0    
+2945 *05F5E101 -1 6CAA -1    
+2960 *05F5E101 -1 6CA9 -1    
+2975 *05F5E0FF 1 6CAA 1    
+2990 *05F5E0FE 2 6CBE 20    
+3005 *05F5E0FF 1 6CBF 1    
+3020 *05F5E0FF 1 6CC0 1    
+3035 *05F5E101 -1 6CBF -1    
+3050 *05F5E0FE 2 6CD3 20    
+3065 *05F5E100 0 6CD3 0    
+3080 *05F5E101 -1 6CD2 -1    
+3095 *05F5E0FD 3 6DB3 225    
+3110 *05F5E0FF 1 6DB4 1    
+3125 *05F5E101 -1 6DB3 -1    
+3140 *05F5E0FF 1 6DB4 1    
+3155 *05F5E100 0 6DB4 0    
+3170 *05F5E100 0 6DB4 0    
+3185 *05F5E101 -1 6DB3 -1    
+3200 *05F5E0FF 1 6DB4 1    
+3215 *05F5E103 -3 6CD3 -225    
+3230 *05F5E0FF 1 6CD4 1    
+3245 *05F5E0FD 3 6DB5 225    
+3260 *05F5E100 0 6DB5 0    
+3275 *05F5E103 -3 6CD4 -225    
+3290 *05F5E101 -1 6CD3 -1    
+3305 *05F5E100 0 6CD3 0    
+3320 *05F5E0FD 3 6DB4 225    
+3335 *05F5E100 0 6DB4 0    
+3350 *05F5E101 -1 6DB3 -1    
+3365 *05F5E0FF 1 6DB4 1    
+3380 *05F5E0FF 1 6DB5 1    
+3395 *05F5E0FF 1 6DB6 1    
+3410 *05F5E0FF 1 6DB7 1    
+3425 *05F5E0FF 1 6DB8 1    
+3440 *05F5E100 0 6DB8 0    
+3455 *05F5E102 -2 6DA4 -20    
+3470 *05F5E103 -3 6CC3 -225    
+3485 *05F5E100 0 6CC3 0    
+3500 *05F5E100 0 6CC3 0    
+3515 *05F5E101 -1 6CC2 -1    
+3530 *05F5E0FE 2 6CD6 20    
+3545 *05F5E0FF 1 6CD7 1    
+3560 *05F5E100 0 6CD7 0    
+3575 *05F5E101 -1 6CD6 -1    
+3590 *05F5E102 -2 6CC2 -20    
+3605 *05F5E100 0 6CC2 0    
+3620 *05F5E100 0 6CC2 0    
+3635 *05F5E101 -1 6CC1 -1    
+3650 *05F5E100 0 6CC1 0    
+3665 *05F5E0FE 2 6CD5 20    
+3680 *05F5E102 -2 6CC1 -20    
+3695 *05F5E0FE 2 6CD5 20    
+3710 *05F5E0FF 1 6CD6 1    
+3725 *05F5E102 -2 6CC2 -20    
+3740 *05F5E0FE 2 6CD6 20    
+3755 *05F5E102 -2 6CC2 -20    
+3770 *05F5E102 -2 6CAE -20    
+3785 *05F5E102 -2 6C9A -20    
+3800 *05F5E0FF 1 6C9B 1    
+3815 *05F5E101 -1 6C9A -1    
+3830 *05F5E101 -1 6C99 -1    
+3845 *05F5E0FE 2 6CAD 20    
+3860 *05F5E102 -2 6C99 -20    
+3875 *05F5E0FD 3 6D7A 225    
+3890 *05F5E0FF 1 6D7B 1    
+3905 *05F5E0FE 2 6D8F 20    
+3920 *05F5E102 -2 6D7B -20    
+3935 *05F5E102 -2 6D67 -20    
+3950 *05F5E100 0 6D67 0    
+3965 *05F5E101 -1 6D66 -1    
+3980 *05F5E102 -2 6D52 -20    
+3995 *05F5E101 -1 6D51 -1    
+4010 *05F5E102 -2 6D3D -20    
+4025 *05F5E101 -1 6D3C -1    
+4040 *05F5E0FE 2 6D50 20    
+4055 *05F5E101 -1 6D4F -1    
+4070 *05F5E0FF 1 6D50 1    
+4085 *05F5E0FF 1 6D51 1    
+4100 *05F5E0FF 1 6D52 1    
+4115 *05F5E0FE 2 6D66 20    
+4130 *05F5E0FF 1 6D67 1    
+4145 *05F5E101 -1 6D66 -1    
+4160 *05F5E102 -2 6D52 -20    
+4175 *05F5E0FF 1 6D53 1    
+4190 *05F5E101 -1 6D52 -1    
+4205 *05F5E100 0 6D52 0    
+4220 *05F5E101 -1 6D51 -1    
+4235 *05F5E100 0 6D51 0    
+4250 *05F5E0FF 1 6D52 1    
+4265 *05F5E102 -2 6D3E -20    
+4280 *05F5E0FE 2 6D52 20    
+4295 *05F5E0FE 2 6D66 20    
+4310 *05F5E100 0 6D66 0    
+4325 *05F5E0FD 3 6E47 225    
+4340 *05F5E0FF 1 6E48 1    
+4355 *05F5E0FF 1 6E49 1    
+4370 *05F5E0FF 1 6E4A 1    
+4385 *05F5E102 -2 6E36 -20    
+4400 *05F5E100 0 6E36 0    
+4415 *05F5E100 0 6E36 0    
+4430 *05F5E101 -1 6E35 -1    
+4445 *05F5E101 -1 6E34 -1    
+4460 *05F5E100 0 6E34 0    
+4475 *05F5E100 0 6E34 0    
+4490 *05F5E103 -3 6D53 -225    
+4505 *05F5E101 -1 6D52 -1    
+4520 *05F5E0FF 1 6D53 1    
+4535 *05F5E0FF 1 6D54 1    
+4550 *05F5E101 -1 6D53 -1    
+4565 *05F5E100 0 6D53 0    
+4580 *05F5E100 0 6D53 0    
+4595 *05F5E0FF 1 6D54 1    
+4610 *05F5E101 -1 6D53 -1    
+4625 *05F5E0FE 2 6D67 20    
+4640 *05F5E0FF 1 6D68 1    
+4655 *05F5E100 0 6D68 0    
+4670 *05F5E100 0 6D68 0    
+4685 *05F5E100 0 6D68 0    
+4700 *05F5E100 0 6D68 0    
+4715 *05F5E100 0 6D68 0    
+4730 *05F5E102 -2 6D54 -20    
+4745 *05F5E0FF 1 6D55 1    
+4760 *05F5E100 0 6D55 0    
+4775 *05F5E103 -3 6C74 -225    
+4790 *05F5E102 -2 6C60 -20    
+4805 *05F5E0FF 1 6C61 1    
+4820 *05F5E0FF 1 6C62 1    
+4835 *05F5E103 -3 6B81 -225    
+4850 *05F5E0FF 1 6B82 1    
+4865 *05F5E101 -1 6B81 -1    
+4880 *05F5E0FF 1 6B82 1    
+4895 *05F5E101 -1 6B81 -1    
+4910 *05F5E100 0 6B81 0    
+4925 *05F5E0FF 1 6B82 1    
+4940 *05F5E0FE 2 6B96 20    
+4955 *05F5E0FF 1 6B97 1    
+4970 *05F5E102 -2 6B83 -20    
+4985 *05F5E100 0 6B83 0    
+5000 *05F5E100 0 6B83 0    
+5015 *05F5E100 0 6B83 0    
+5030 *05F5E102 -2 6B6F -20    
+5045 *05F5E100 0 6B6F 0    
+5060 *05F5E102 -2 6B5B -20    
+5075 *05F5E104 -4 6A2F -300    
+5090 *05F5E102 -2 6A1B -20    
+5105 *05F5E0FC 4 6B47 300    
+5120 *05F5E101 -1 6B46 -1    
+5135 *05F5E101 -1 6B45 -1    
+5150 *05F5E100 0 6B45 0    
+5165 *05F5E103 -3 6A64 -225    
+5180 *05F5E100 0 6A64 0    
+5195 *05F5E102 -2 6A50 -20    
+5210 *05F5E0FC 4 6B7C 300    
+5225 *05F5E0FE 2 6B90 20    
+5240 *05F5E101 -1 6B8F -1    
+5255 *05F5E100 0 6B8F 0    
+5270 *05F5E101 -1 6B8E -1    
+5285 *05F5E100 0 6B8E 0    
+5300 *05F5E102 -2 6B7A -20    
+5315 *05F5E100 0 6B7A 0    
+5330 *05F5E100 0 6B7A 0    
+5345 *05F5E100 0 6B7A 0    
+5360 *05F5E101 -1 6B79 -1    
+5375 *05F5E0FF 1 6B7A 1    
+5390 *05F5E0FF 1 6B7B 1    
+5405 *05F5E101 -1 6B7A -1    
+5420 *05F5E101 -1 6B79 -1    
+5435 *05F5E0FD 3 6C5A 225    
+5450 *05F5E0FD 3 6D3B 225    
+5465 *05F5E101 -1 6D3A -1    
+5480 *05F5E103 -3 6C59 -225    
+5495 *05F5E0FF 1 6C5A 1    
+5510 *05F5E100 0 6C5A 0    
+5525 *05F5E102 -2 6C46 -20    
+5540 *05F5E102 -2 6C32 -20    
+5555 *05F5E100 0 6C32 0    
+5570 *05F5E101 -1 6C31 -1    
+5585 *05F5E0FF 1 6C32 1    
+5600 *05F5E0FE 2 6C46 20    
+5615 *05F5E0FE 2 6C5A 20    
+5630 *05F5E100 0 6C5A 0    
+5645 *05F5E0FF 1 6C5B 1    
+5660 *05F5E100 0 6C5B 0    
+5675 *05F5E102 -2 6C47 -20    
+5690 *05F5E0FF 1 6C48 1    
+5705 *05F5E0FF 1 6C49 1    
+5720 *05F5E101 -1 6C48 -1    
+5735 *05F5E0FF 1 6C49 1    
+5750 *05F5E100 0 6C49 0    
+5765 *05F5E100 0 6C49 0    
+5780 *05F5E101 -1 6C48 -1    
+5795 *05F5E0FF 1 6C49 1    
+5810 *05F5E0FF 1 6C4A 1    
+5825 *05F5E103 -3 6B69 -225    
+5840 *05F5E0FF 1 6B6A 1    
+5855 *05F5E101 -1 6B69 -1    
+5870 *05F5E0FD 3 6C4A 225    
+5885 *05F5E102 -2 6C36 -20    
+5900 *05F5E0FE 2 6C4A 20    
+5915 *05F5E100 0 6C4A 0    
+5930 *05F5E101 -1 6C49 -1    
+5945 *05F5E0FF 1 6C4A 1    
+5960 *05F5E0FF 1 6C4B 1    
+5975 *05F5E101 -1 6C4A -1    
+5990 *05F5E0FE 2 6C5E 20    
+6005 *05F5E0FE 2 6C72 20    
+6020 *05F5E0FE 2 6C86 20    
+6035 *05F5E100 0 6C86 0    
+6050 *05F5E0FF 1 6C87 1    
+6065 *05F5E104 -4 6B5B -300    
+6080 *05F5E100 0 6B5B 0    
+6095 *05F5E100 0 6B5B 0    
+6110 *05F5E101 -1 6B5A -1    
+6125 *05F5E100 0 6B5A 0    
+6140 *05F5E101 -1 6B59 -1    
+6155 *05F5E100 0 6B59 0    
+6170 *05F5E101 -1 6B58 -1    
+6185 *05F5E101 -1 6B57 -1    
+6200 *05F5E102 -2 6B43 -20    
+6215 *05F5E102 -2 6B2F -20    
+6230 *05F5E100 0 6B2F 0    
+6245 *05F5E102 -2 6B1B -20    
+6260 *05F5E100 0 6B1B 0    
+6275 *05F5E101 -1 6B1A -1    
+6290 *05F5E100 0 6B1A 0    
+6305 *05F5E0FF 1 6B1B 1    
+6320 *05F5E100 0 6B1B 0    
+6335 *05F5E100 0 6B1B 0    
+6350 *05F5E100 0 6B1B 0    
+6365 *05F5E103 -3 6A3A -225    
+6380 *05F5E0FF 1 6A3B 1    
+6395 *05F5E0FF 1 6A3C 1    
+6410 *05F5E101 -1 6A3B -1    
+6425 *05F5E104 -4 690F -300    
+6440 *05F5E101 -1 690E -1    
+6455 *05F5E0FE 2 6922 20    
+6470 *05F5E102 -2 690E -20    
+6485 *05F5E0FF 1 690F 1    
+6500 *05F5E100 0 690F 0    
+6515 *05F5E0FF 1 6910 1    
+6530 *05F5E102 -2 68FC -20    
+6545 *05F5E0FE 2 6910 20    
+6560 *05F5E101 -1 690F -1    
+6575 *05F5E0FF 1 6910 1    
+6590 *05F5E100 0 6910 0    
+6605 *05F5E100 0 6910 0    
+6620 *05F5E101 -1 690F -1    
+6635 *05F5E100 0 690F 0    
+6650 *05F5E102 -2 68FB -20    
+6665 *05F5E100 0 68FB 0    
+6680 *05F5E101 -1 68FA -1    
+6695 *05F5E0FE 2 690E 20    
+6710 *05F5E0FE 2 6922 20    
+6725 *05F5E100 0 6922 0    
+6740 *05F5E0FF 1 6923 1    
+6755 *05F5E100 0 6923 0    
+6770 *05F5E0FF 1 6924 1    
+6785 *05F5E100 0 6924 0    
+6800 *05F5E103 -3 6843 -225    
+6815 *05F5E101 -1 6842 -1    
+6830 *05F5E101 -1 6841 -1    
+6845 *05F5E101 -1 6840 -1    
+6860 *05F5E101 -1 683F -1    
+6875 *05F5E101 -1 683E -1    
+6890 *05F5E102 -2 682A -20    
+6905 *05F5E101 -1 6829 -1    
+6920 *05F5E0FF 1 682A 1    
+6935 *05F5E100 0 682A 0    
+6950 *05F5E0FE 2 683E 20    
+6965 *05F5E100 0 683E 0    
+6980 *05F5E101 -1 683D -1    
+6995 *05F5E103 -3 675C -225    
+7010 *05F5E100 0 675C 0    
+7025 *05F5E103 -3 667B -225    
+7040 *05F5E100 0 667B 0    
+7055 *05F5E100 0 667B 0    
+7070 *05F5E104 -4 654F -300    
+7085 *05F5E101 -1 654E -1    
+7100 *05F5E101 -1 654D -1    
+7115 *05F5E101 -1 654C -1    
+7130 *05F5E101 -1 654B -1    
+7145 *05F5E100 0 654B 0    
+7160 *05F5E101 -1 654A -1    
+7175 *05F5E0FE 2 655E 20    
+7190 *05F5E0FC 4 668A 300    
@@ -0,0 +1,250 @@
+/*
+ * replay: run a recorded stream of 1PPS captures through a control loop
+ *
+ * Copyright 2014-2017 Glen Overby
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * usage: replay [-a pid2|p] [log]
+ *
+ * Reads the log (or stdin), feeds each second's count to the controller,
+ * and prints the controller's status lines ("==", "**", "*" and state
+ * changes), each prefixed with the second it was printed in.
+ *
+ * The counts are taken from any of:
+ *   - a count on a line by itself, as written by sim -r
+ *   - p's "c<count> <sum>" reports (hex)
+ *   - freq-find's "1 <count> <error> <duty>" lines (hex)
+ *   - pid2's DEBUG_SEC_SHORT errors from 10mhz (decimal, several a line,
+ *     told from counts by being under 1,000,000).  These are printed after
+ *     the outlier filter, so an outlier shows as the median that replaced
+ *     it.
+ * Other lines are skipped.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <unistd.h>
+#include "gpsdo.h"
+#include "pid2.h"
+#include "p.h"
+
+#define POLLS   4               // main loop passes per second
+
+//
+// Board interface.  The 1PPS signal is always present.
+//
+volatile uint16_t wraps = 0;
+volatile uint16_t ppswraps = 0;
+volatile long capture = 0;
+volatile char lost = 0;
+
+static long sec;                // seconds replayed
+static void (*second)(long c);  // the controller's 1PPS step
+static char line[128];          // controller output line
+static int len;
+
+// Print the status lines, less any DEBUG_SEC_SHORT errors in front of them
+void
+tx (char c)
+{
+    if (c == '\r' || c == '\n') {
+        line[len] = '\0';
+        if (line[0] == '=' || line[0] == '*' || line[0] == '>')
+            printf("%ld %s\n", sec, line);
+        len = 0;
+    } else if (len == 0 && (c == ' ' || c == '-' || isdigit((unsigned char) c))) {
+        ;
+    } else if (len < sizeof(line) - 1) {
+        line[len++] = c;
+    }
+}
+
+void
+pwm_set (unsigned int duty)
+{
+}
+
+void
+ledstate (int blue, int green, int yellow)
+{
+}
+
+int
+osc_cold (void)
+{
+    return 0;
+}
+
+int
+gps_nolock (void)
+{
+    return 0;
+}
+
+#if TUNABLE
+int
+tune_load (struct tune *t)
+{
+    return 0;
+}
+
+void
+tune_save (const struct tune *t)
+{
+}
+#endif
+
+//
+// Controllers
+//
+static void
+pid2_init (void)
+{
+    control_init(PWM_START);
+}
+
+static void
+pid2_second (long c)
+{
+    int i;
+
+    for (i = 0; i < POLLS; i++)
+        control_poll();
+    control_pps(c);
+}
+
+static void
+p_start (void)
+{
+    p_init(P_START);
+}
+
+static void
+p_second (long c)
+{
+    p_pps(c);
+}
+
+static const struct {
+    const char *name;
+    void (*init)(void);
+    void (*second)(long c);
+} algs[] = {
+    { "pid2",   pid2_init,      pid2_second },
+    { "p",      p_start,        p_second },
+    { NULL }
+};
+
+static void
+feed (long c)
+{
+    sec++;
+    second(c);
+}
+
+// Find the counts in a log line and feed them to the controller
+static void
+counts (char *s)
+{
+    char *e;
+    long v;
+
+    while (*s == ' ' || *s == '\t')
+        s++;
+
+    // p: c<count> <sum>
+    if (s[0] == 'c' && isxdigit((unsigned char) s[1])) {
+        v = strtoul(s + 1, &e, 16);
+        if (e - s == 9)
+            feed(v);
+        return;
+    }
+
+    // freq-find: 1 <count> <error> <duty>
+    if (s[0] == '1' && s[1] == ' ') {
+        v = strtoul(s + 2, &e, 16);
+        if (e - s == 10 && *e == ' ') {
+            feed(v);
+            return;
+        }
+    }
+
+    // a count, or pid2's errors from 10mhz
+    for (;;) {
+        v = strtol(s, &e, 10);
+        if (e == s || (*e != '\0' && !isspace((unsigned char) *e)))
+            break;
+        if (labs(v) < 1000000)
+            v = 10000000 - v;
+        feed(v);
+        for (s = e; *s == ' ' || *s == '\t'; s++)
+            ;
+    }
+}
+
+static void
+usage (void)
+{
+    fprintf(stderr, "usage: replay [-a pid2|p] [log]\n");
+    exit(2);
+}
+
+int
+main (int argc, char **argv)
+{
+    FILE *f = stdin;
+    char buf[1024];
+    char *s, *r;
+    int a = 0;
+    int ch;
+
+    while ((ch = getopt(argc, argv, "a:")) != -1) {
+        switch (ch) {
+        case 'a':
+            for (a = 0; algs[a].name; a++)
+                if (strcmp(algs[a].name, optarg) == 0)
+                    break;
+            if (algs[a].name == NULL) {
+                fprintf(stderr, "replay: unknown controller %s\n", optarg);
+                exit(2);
+            }
+            break;
+        default:
+            usage();
+        }
+    }
+    if (optind < argc - 1)
+        usage();
+    if (optind < argc && (f = fopen(argv[optind], "r")) == NULL) {
+        perror(argv[optind]);
+        exit(1);
+    }
+
+    second = algs[a].second;
+    algs[a].init();
+    while (fgets(buf, sizeof(buf), f)) {
+        // p overwrites its count report with '\r'
+        for (s = buf; s; s = r) {
+            if ((r = strchr(s, '\r')) != NULL)
+                *r++ = '\0';
+            if (*s == '=' || *s == '*' || *s == '>' || *s == '#')
+                continue;
+            counts(s);
+        }
+    }
+    tx('\n');
+    return 0;
+}
@@ -0,0 +1,63 @@
+#!/bin/sh
+#
+# Replay each capture log through each controller and compare the output
+# with the golden files.
+#
+# usage: run.sh replay [dir]
+#
+# dir (default the directory of this script) holds logs/*.log and
+# golden/<log>.<controller>.  A missing golden file is created.  With
+# REPLAY_UPDATE=1 all of them are rewritten from this run.
+#
+# Exits with status 1 if any output differs.
+#
+
+REPLAY=${1:-build/replay}
+DIR=${2:-`dirname $0`}
+CONTROLLERS=${REPLAY_CONTROLLERS:-"pid2 p"}
+OUT=${TMPDIR:-/tmp}/replay.$$
+
+trap 'rm -f $OUT' 0
+status=0
+mkdir -p $DIR/golden
+
+for log in $DIR/logs/*.log; do
+    [ -f "$log" ] || continue
+    for c in $CONTROLLERS; do
+        golden=$DIR/golden/`basename $log .log`.$c
+        name=`basename $log`/$c
+        $REPLAY -a $c $log > $OUT || exit 2
+
+        if [ ! -f $golden ] || [ "$REPLAY_UPDATE" = 1 ]; then
+            cp $OUT $golden
+            printf "%-32s %s\n" $name "written"
+            continue
+        fi
+
+        # Count the changed lines of each kind: "<second> == ...",
+        # "<second> ** ...", "<second> *...", "<second> > state: ..."
+        diff $golden $OUT | awk -v name=$name '
+            /^[<>] / {
+                k = $3
+                if (k != "==" && k != "**" && k != ">")
+                    k = "*"
+                n[k]++
+                total++
+            }
+            END {
+                if (total == 0) {
+                    printf "%-32s same\n", name
+                    exit 0
+                }
+                printf "%-32s %d lines differ:", name, total
+                for (k in n)
+                    printf " %s %d", k, n[k]
+                printf "\n"
+                exit 1
+            }' || {
+            status=1
+            diff -u $golden $OUT | sed -n '3,12p'
+        }
+    done
+done
+exit $status
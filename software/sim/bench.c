@@ -0,0 +1,277 @@
+/*
+ * bench.c - Lock time and stability benchmark for the pid2 control loop
+ *
+ * Copyright 2014-2017 Glen Overby
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Runs the simulator over every oscillator profile, power on duty cycle,
+ * GPS jitter and temperature scenario, and writes one CSV line per run:
+ *
+ *  fast_lock   second FAST first measured no error (solid yellow)
+ *  slow        second SLOW was first entered
+ *  slow_lock   second SLOW first made no adjustment (solid green)
+ *  fallbacks   times SLOW fell back to FASTINIT
+ *  outliers    seconds replaced by the outlier filter
+ *  adev100     Allan deviation at 100 and 1000 seconds of the oscillator,
+ *  adev1000      from the time SLOW was entered to the end of the run
+ *
+ * Times that were never reached, and deviations without enough data, are
+ * -1.  Each run uses its own seed, so a run is repeatable on its own.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "gpsdo.h"
+#include "pid2.h"
+#include "sim.h"
+
+static const unsigned int duties[] = { PWM_START, 0x8000, 0xffff };
+static const double jitters[] = { 5, 20, 100 };         // ns rms
+
+#define NDUTY   (sizeof(duties) / sizeof(duties[0]))
+#define NJITTER (sizeof(jitters) / sizeof(jitters[0]))
+
+struct result {
+    char profile[32];
+    unsigned int duty;
+    double jitter;
+    char temp[16];
+    long fastlock;
+    long slow;
+    long slowlock;
+    long fallbacks;
+    long outliers;
+    double adev100;
+    double adev1000;
+};
+
+#define CSV_HEADER \
+    "profile,duty,jitter_ns,temp,fast_lock,slow,slow_lock,fallbacks,outliers,adev100,adev1000"
+
+//
+// Overlapping Allan deviation at m seconds from n time errors, one a second.
+// Returns -1 if there are fewer than 4m.
+//
+double
+adev (const double *x, long n, long m)
+{
+    double sum = 0, d;
+    long i;
+
+    if (n < 4 * m)
+        return -1;
+    for (i = 0; i + 2 * m < n; i++) {
+        d = x[i + 2 * m] - 2 * x[i + m] + x[i];
+        sum += d * d;
+    }
+    return sqrt(sum / (2.0 * m * m * (n - 2 * m)));
+}
+
+static void
+run (struct result *r, const struct osc *osc, unsigned int duty,
+     double jitter, int temp, int pwmclock, long seconds, unsigned long seed)
+{
+    struct sim s;
+
+    sim_init(&s, osc, seed);
+    s.jitter = jitter * 1e-9;
+    s.temp = temp;
+    s.pwmclock = pwmclock;
+    s.nx = seconds + 1;
+    s.x = calloc(s.nx, sizeof(double));
+    if (s.x == NULL) {
+        perror("sim");
+        exit(1);
+    }
+
+    sim_run(&s, duty, seconds, 0);
+
+    snprintf(r->profile, sizeof(r->profile), "%s", osc->name);
+    r->duty = duty;
+    r->jitter = jitter;
+    snprintf(r->temp, sizeof(r->temp), "%s", temp_names[temp]);
+    r->fastlock = s.fastlock;
+    r->slow = s.slow;
+    r->slowlock = s.slowlock;
+    r->fallbacks = s.fallbacks;
+#if CAPTURE_FILTER
+    r->outliers = outliers;
+#else
+    r->outliers = 0;
+#endif
+    r->adev100 = r->adev1000 = -1;
+    if (s.slow >= 0) {
+        r->adev100 = adev(s.x + s.slow, s.nx - s.slow, 100);
+        r->adev1000 = adev(s.x + s.slow, s.nx - s.slow, 1000);
+    }
+    free(s.x);
+}
+
+static void
+print (FILE *f, const struct result *r)
+{
+    fprintf(f, "%s,%u,%g,%s,%ld,%ld,%ld,%ld,%ld,%.3e,%.3e\n",
+            r->profile, r->duty, r->jitter, r->temp, r->fastlock, r->slow,
+            r->slowlock, r->fallbacks, r->outliers, r->adev100, r->adev1000);
+}
+
+// Read a CSV written by print().  Returns the number of results, or -1.
+static long
+load (const char *file, struct result **rp)
+{
+    FILE *f = fopen(file, "r");
+    char line[256];
+    struct result *r = NULL, *p;
+    long n = 0;
+
+    if (f == NULL)
+        return -1;
+    while (fgets(line, sizeof(line), f)) {
+        if ((n & 63) == 0) {
+            r = realloc(r, (n + 64) * sizeof(*r));
+            if (r == NULL) {
+                perror("sim");
+                exit(1);
+            }
+        }
+        p = &r[n];
+        if (sscanf(line, "%31[^,],%u,%lf,%15[^,],%ld,%ld,%ld,%ld,%ld,%lf,%lf",
+                   p->profile, &p->duty, &p->jitter, p->temp, &p->fastlock,
+                   &p->slow, &p->slowlock, &p->fallbacks, &p->outliers,
+                   &p->adev100, &p->adev1000) == 11)
+            n++;
+    }
+    fclose(f);
+    *rp = r;
+    return n;
+}
+
+//
+// Summary of a benchmark: runs that locked, mean lock times of those runs,
+// total fallbacks, and the median deviations.
+//
+struct summary {
+    double locked, fastlock, slowlock, fallbacks, adev100, adev1000;
+};
+
+static int
+cmpd (const void *a, const void *b)
+{
+    double x = *(const double *) a, y = *(const double *) b;
+
+    return x < y ? -1 : x > y;
+}
+
+static double
+median (double *v, long n)
+{
+    if (n == 0)
+        return -1;
+    qsort(v, n, sizeof(double), cmpd);
+    return v[n / 2];
+}
+
+static void
+summarize (struct summary *s, const struct result *r, long n)
+{
+    double *a1 = malloc((n + 1) * sizeof(double));
+    double *a2 = malloc((n + 1) * sizeof(double));
+    long nf = 0, n1 = 0, n2 = 0;
+    long i;
+
+    memset(s, 0, sizeof(*s));
+    for (i = 0; i < n; i++) {
+        if (r[i].fastlock >= 0) {
+            s->fastlock += r[i].fastlock;
+            nf++;
+        }
+        if (r[i].slowlock >= 0) {
+            s->slowlock += r[i].slowlock;
+            s->locked++;
+        }
+        s->fallbacks += r[i].fallbacks;
+        if (r[i].adev100 >= 0)
+            a1[n1++] = r[i].adev100;
+        if (r[i].adev1000 >= 0)
+            a2[n2++] = r[i].adev1000;
+    }
+    s->fastlock = nf ? s->fastlock / nf : -1;
+    s->slowlock = s->locked ? s->slowlock / s->locked : -1;
+    s->adev100 = median(a1, n1);
+    s->adev1000 = median(a2, n2);
+    free(a1);
+    free(a2);
+}
+
+static void
+compare (const char *name, double old, double new)
+{
+    fprintf(stderr, "%-16s %12.4g %12.4g", name, old, new);
+    if (old > 0)
+        fprintf(stderr, " %+7.1f%%", (new - old) / old * 100);
+    fprintf(stderr, "\n");
+}
+
+int
+sim_bench (long seconds, const char *baseline, int pwmclock)
+{
+    const struct osc *osc;
+    struct result *r, *b;
+    struct summary sr, sb;
+    unsigned long seed = 0;
+    long n = 0, nb;
+    int d, j, t;
+
+    for (osc = osc_profiles; osc->name; osc++)
+        n++;
+    r = calloc(n * NDUTY * NJITTER * (T_RAMP + 1), sizeof(*r));
+    if (r == NULL) {
+        perror("sim");
+        exit(1);
+    }
+
+    printf("%s\n", CSV_HEADER);
+    n = 0;
+    for (osc = osc_profiles; osc->name; osc++)
+        for (d = 0; d < NDUTY; d++)
+            for (j = 0; j < NJITTER; j++)
+                for (t = 0; temp_names[t]; t++) {
+                    run(&r[n], osc, duties[d], jitters[j], t, pwmclock, seconds, ++seed);
+                    print(stdout, &r[n]);
+                    fflush(stdout);
+                    n++;
+                }
+
+    summarize(&sr, r, n);
+    if (baseline && (nb = load(baseline, &b)) > 0) {
+        summarize(&sb, b, nb);
+        free(b);
+    } else {
+        sb = sr;
+        baseline = NULL;
+    }
+
+    fprintf(stderr, "%-16s %12s %12s\n", "", baseline ? "baseline" : "", "this run");
+    fprintf(stderr, "%-16s %12.0f %12.0f of %ld\n", "slow-locked", sb.locked, sr.locked, n);
+    compare("fast-lock s", sb.fastlock, sr.fastlock);
+    compare("slow-lock s", sb.slowlock, sr.slowlock);
+    compare("fallbacks", sb.fallbacks, sr.fallbacks);
+    compare("adev(100s)", sb.adev100, sr.adev100);
+    compare("adev(1000s)", sb.adev1000, sr.adev1000);
+    free(r);
+    return 0;
+}
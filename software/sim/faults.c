@@ -0,0 +1,286 @@
+/*
+ * faults: fault injection suite for pid2's error states
+ *
+ * Copyright 2014-2017 Glen Overby
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * usage: faults [-v] [-n runs] [-f fault]
+ *
+ *  -v  print the firmware's serial output
+ *  -n  runs of each fault, with different seeds (default 3)
+ *  -f  run only this fault
+ *
+ * Each run brings the simulated isotemp oscillator to SLOW lock, lets it
+ * settle, injects a fault, and checks that:
+ *
+ *  - a fault the firmware should ride through causes no error state (and,
+ *    unless it is allowed to, no fall back to FAST)
+ *  - any other fault puts the firmware in its error state within the
+ *    allowed time, once, and it stays there while the fault lasts, even a
+ *    fault that comes and goes
+ *  - the firmware is back in SLOW within the allowed time of the fault
+ *    ending, and stays there for an hour, with no error state and (unless
+ *    it is allowed one) no fall back
+ *
+ * Prints a line for each run and the reasons for any failure, and exits 1
+ * if any run failed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "gpsdo.h"
+#include "pid2.h"
+#include "sim.h"
+
+#define JITTER          20e-9   // GPS 1PPS jitter, seconds rms
+#define LOCK_LIMIT      3600    // seconds allowed for the first SLOW lock
+#define SETTLE          600     // seconds in SLOW lock before the fault
+#define HOLD            3600    // seconds SLOW must hold after recovering
+
+// Faults
+#define F_PPS           0       // no 1PPS edges from the GPS
+#define F_OSC           1       // the oscillator stops
+#define F_COLD          2       // the oscillator's cold pin is set
+#define F_NOLOCK        3       // the GPS's no lock pin is set
+#define F_DOUBLE        4       // an extra 1PPS edge every second
+#define F_RESET         5       // a watchdog reset, at the start
+
+struct fault {
+    const char *name;
+    int kind;
+    long length;                // seconds the fault lasts
+    long on, off;               // it comes and goes: on, then off, seconds (0: steady)
+    char error;                 // error state it causes, or 0: ridden through
+    int fallback;               //   ridden through, but may fall back to FAST
+    long detect;                // seconds to enter the error state, at most
+    long recover;               // seconds from the end of the fault to SLOW, at most
+};
+
+// A lost 1PPS is seen PPS_HOLDOFF (15) seconds after the last edge, and a
+// stopped oscillator OSC_HOLDOFF (100) milliseconds after it stops.
+static const struct fault faults[] = {
+    //  name                kind        length  on  off error       fb  detect  recover
+    { "pps-missed-1s",      F_PPS,      1,      0,  0,  0,          0,  0,      0 },
+    { "pps-missed-5s",      F_PPS,      5,      0,  0,  0,          0,  0,      0 },
+    { "pps-missed-14s",     F_PPS,      14,     0,  0,  0,          0,  0,      0 },
+    { "pps-lost-1m",        F_PPS,      60,     0,  0,  NOGPSPPS,   0,  16,     120 },
+    { "pps-lost-1h",        F_PPS,      3600,   0,  0,  NOGPSPPS,   0,  16,     120 },
+    { "pps-flapping",       F_PPS,      300,    20, 3,  NOGPSPPS,   0,  16,     120 },
+    { "pps-double-1",       F_DOUBLE,   1,      0,  0,  0,          0,  0,      0 },
+    { "pps-double-30s",     F_DOUBLE,   30,     0,  0,  0,          1,  0,      120 },
+    { "wdt-reset",          F_RESET,    1,      0,  0,  0,          0,  0,      0 },
+    { "osc-stopped-5s",     F_OSC,      5,      0,  0,  NOOSCCLOCK, 0,  1,      120 },
+    { "osc-lost-1m",        F_OSC,      60,     0,  0,  NOOSCCLOCK, 0,  1,      120 },
+    { "osc-lost-10m",       F_OSC,      600,    0,  0,  NOOSCCLOCK, 0,  1,      120 },
+    { "osc-flapping",       F_OSC,      300,    20, 3,  NOOSCCLOCK, 0,  1,      120 },
+    { "osc-cold-10m",       F_COLD,     600,    0,  0,  OSCCOLD,    0,  1,      120 },
+    { "osc-cold-bounce",    F_COLD,     30,     1,  1,  OSCCOLD,    0,  1,      120 },
+    { "gps-nolock-10m",     F_NOLOCK,   600,    0,  0,  NOGPSLOCK,  0,  1,      120 },
+    { "gps-lock-flapping",  F_NOLOCK,   120,    2,  3,  NOGPSLOCK,  0,  1,      120 },
+    { NULL }
+};
+
+static const char *states[] = {
+    "START", "CHECKERRORS", "OSCCOLD", "NOOSCCLOCK", "NOGPSPPS", "NOGPSLOCK",
+    "GOOD", "FASTINIT", "FASTWAIT", "FAST", "SLOWINIT", "SLOW", "TUNE"
+};
+
+static int verbose;
+static char reasons[512];       // why the run failed, a line each
+
+static void
+inject (struct sim *s, int kind, int on)
+{
+    switch (kind) {
+    case F_PPS:
+        s->nopps = on;
+        break;
+    case F_OSC:
+        s->noosc = on;
+        break;
+    case F_COLD:
+        s->cold = on;
+        break;
+    case F_NOLOCK:
+        s->nolock = on;
+        break;
+    }
+}
+
+static int
+failed (int fail, const char *why)
+{
+    size_t n = strlen(reasons);
+
+    snprintf(reasons + n, sizeof(reasons) - n, "    %s\n", why);
+    return fail + 1;
+}
+
+// Run one fault.  Returns the number of checks that failed.
+static int
+run (const struct fault *f, unsigned long seed)
+{
+    struct sim s;
+    char why[96];
+    long t, detected = -1, left = -1, back = 0;
+    long errors, fallbacks;
+    int on, fail = 0;
+
+    reasons[0] = '\0';
+    sim_init(&s, &osc_profiles[0], seed);
+    s.jitter = JITTER;
+    s.verbose = verbose;
+    control_init(PWM_START);
+
+    for (t = 0; t < LOCK_LIMIT && s.slowlock < 0; t++)
+        sim_second(&s, G_NONE);
+    for (t = 0; t < SETTLE; t++)
+        sim_second(&s, G_NONE);
+    if (state != SLOW) {
+        printf("%-18s %4lu  not in SLOW before the fault: FAIL\n", f->name, seed);
+        return 1;
+    }
+
+    // the fault
+    errors = s.errors;
+    fallbacks = s.fallbacks;
+    for (t = 0; t < f->length; t++) {
+        on = f->on == 0 || t % (f->on + f->off) < f->on;
+        inject(&s, f->kind, on);
+        if (f->kind == F_RESET && t == 0)
+            sim_reset(&s);
+        sim_second(&s, f->kind == F_DOUBLE && on ? G_DOUBLE : G_NONE);
+        if (detected < 0 && f->error && state == f->error)
+            detected = t + 1;
+        else if (detected >= 0 && left < 0 && state != f->error)
+            left = t + 1;
+        if (!f->error && !f->fallback && state != SLOW && left < 0)
+            left = t + 1;
+    }
+    inject(&s, f->kind, 0);
+
+    if (f->error) {
+        if (detected < 0) {
+            snprintf(why, sizeof(why), "never entered %s", states[(int) f->error]);
+            fail = failed(fail, why);
+        } else if (detected > f->detect) {
+            snprintf(why, sizeof(why), "entered %s after %ld seconds, allowed %ld",
+                     states[(int) f->error], detected, f->detect);
+            fail = failed(fail, why);
+        }
+        if (left >= 0) {
+            snprintf(why, sizeof(why), "left %s at %ld seconds, with the fault",
+                     states[(int) f->error], left);
+            fail = failed(fail, why);
+        }
+        if (s.errors - errors > 1) {
+            snprintf(why, sizeof(why), "entered an error state %ld times",
+                     s.errors - errors);
+            fail = failed(fail, why);
+        }
+    } else {
+        if (s.errors != errors)
+            fail = failed(fail, "entered an error state");
+        if (left >= 0) {
+            snprintf(why, sizeof(why), "left SLOW at %ld seconds", left);
+            fail = failed(fail, why);
+        }
+    }
+
+    // recovery: the last second out of SLOW, of the allowed time and an
+    // hour after
+    errors = s.errors;
+    for (t = 0; t < f->recover + HOLD; t++) {
+        if (state != SLOW)
+            back = t + 1;
+        sim_second(&s, G_NONE);
+    }
+    if (state != SLOW)
+        back = t;
+    if (back > f->recover) {
+        snprintf(why, sizeof(why), "out of SLOW %ld seconds after the fault, allowed %ld",
+                 back, f->recover);
+        fail = failed(fail, why);
+    }
+    if (s.errors != errors) {
+        snprintf(why, sizeof(why), "entered an error state %ld times after the fault",
+                 s.errors - errors);
+        fail = failed(fail, why);
+    }
+    if (s.fallbacks - fallbacks > f->fallback) {
+        snprintf(why, sizeof(why), "fell back to FAST %ld times",
+                 s.fallbacks - fallbacks);
+        fail = failed(fail, why);
+    }
+
+    if (f->error)
+        printf("%-18s %4lu  %-10s after %4ld s", f->name, seed,
+               states[(int) f->error], detected);
+    else
+        printf("%-18s %4lu  %-10s %12s", f->name, seed, "-", "");
+    printf("  back in SLOW %4ld s  %s\n", back, fail ? "FAIL" : "pass");
+    fputs(reasons, stdout);
+    return fail;
+}
+
+static void
+usage (void)
+{
+    fprintf(stderr, "usage: faults [-v] [-n runs] [-f fault]\n");
+    exit(2);
+}
+
+int
+main (int argc, char **argv)
+{
+    const struct fault *f;
+    const char *only = NULL;
+    long runs = 3;
+    long n, failures = 0, total = 0;
+    int ch;
+
+    while ((ch = getopt(argc, argv, "vn:f:")) != -1) {
+        switch (ch) {
+        case 'v':
+            verbose = 1;
+            break;
+        case 'n':
+            runs = atol(optarg);
+            break;
+        case 'f':
+            only = optarg;
+            break;
+        default:
+            usage();
+        }
+    }
+    if (runs <= 0)
+        usage();
+
+    for (f = faults; f->name; f++) {
+        if (only && strcmp(only, f->name) != 0)
+            continue;
+        for (n = 1; n <= runs; n++, total++)
+            if (run(f, n))
+                failures++;
+    }
+    if (total == 0) {
+        fprintf(stderr, "faults: unknown fault %s\n", only);
+        exit(2);
+    }
+    printf("%ld of %ld runs failed\n", failures, total);
+    return failures != 0;
+}
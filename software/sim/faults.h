@@ -0,0 +1,31 @@
+/*
+ * faults.h - pid2 constants for the fault injection suite
+ *
+ * Copyright 2014-2017 Glen Overby
+ * 
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * control.c is built with -DOSC_PROFILE='"faults.h"' for the fault suite:
+ * isotemp.h's constants, with the GPS lock check turned on so the suite
+ * can exercise it.
+ */
+
+#ifndef FAULTS_H
+#define FAULTS_H
+
+#include "isotemp.h"
+
+#undef HAVE_GPSLOCK
+#define HAVE_GPSLOCK 1
+
+#endif /* FAULTS_H */
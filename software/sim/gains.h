@@ -0,0 +1,66 @@
+/*
+ * gains.h - pid2 controller constants in variables
+ *
+ * Copyright 2014-2017 Glen Overby
+ * 
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * control.c is built with -DOSC_PROFILE='"gains.h"' for the gain sweep and
+ * the tuner, which set the gains before each run.  The rest of the
+ * constants, and the starting values, are isotemp.h's.
+ */
+
+#ifndef GAINS_H
+#define GAINS_H
+
+#include <stdint.h>
+#include "isotemp.h"
+
+struct gains {
+    int16_t p_fast;             // P_FACTOR_FAST
+    int16_t max_error;          // P_MAX_ERROR
+    int16_t p_slow;             // P_FACTOR_SLOW
+    int16_t i_slow;             // I_FACTOR_SLOW
+    int16_t p_band;             // P_ERRORBAND_SLOW
+    int16_t i_band;             // I_ERRORBAND_SLOW
+};
+
+extern struct gains gains;
+
+enum {
+    DEFAULT_P_FACTOR_FAST = P_FACTOR_FAST,
+    DEFAULT_P_MAX_ERROR = P_MAX_ERROR,
+    DEFAULT_P_FACTOR_SLOW = P_FACTOR_SLOW,
+    DEFAULT_I_FACTOR_SLOW = I_FACTOR_SLOW,
+    DEFAULT_P_ERRORBAND_SLOW = P_ERRORBAND_SLOW,
+    DEFAULT_I_ERRORBAND_SLOW = I_ERRORBAND_SLOW,
+};
+
+#define DEFAULT_GAINS { DEFAULT_P_FACTOR_FAST, DEFAULT_P_MAX_ERROR, \
+                        DEFAULT_P_FACTOR_SLOW, DEFAULT_I_FACTOR_SLOW, \
+                        DEFAULT_P_ERRORBAND_SLOW, DEFAULT_I_ERRORBAND_SLOW }
+
+#undef P_FACTOR_FAST
+#undef P_MAX_ERROR
+#undef P_FACTOR_SLOW
+#undef I_FACTOR_SLOW
+#undef P_ERRORBAND_SLOW
+#undef I_ERRORBAND_SLOW
+#define P_FACTOR_FAST           gains.p_fast
+#define P_MAX_ERROR             gains.max_error
+#define P_FACTOR_SLOW           gains.p_slow
+#define I_FACTOR_SLOW           gains.i_slow
+#define P_ERRORBAND_SLOW        gains.p_band
+#define I_ERRORBAND_SLOW        gains.i_band
+
+#endif /* GAINS_H */
@@ -0,0 +1,631 @@
+/*
+ * isr: checks of the counter's interrupt handlers
+ *
+ * Copyright 2014-2017 Glen Overby
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * usage: isr [-v] [-c check]
+ *
+ *  -v  print each 1PPS capture and output edge
+ *  -c  run only this check
+ *
+ * common/counter.c is built for the host against a model of timer 0
+ * (timer.h).  The model counts the oscillator at exactly 10mhz and
+ * captures the 1PPS input in register 0, setting COV for a second capture
+ * before the first was taken.  Compare 1's output unit makes the 1PPS
+ * output's edges, set in mode 1 and reset in mode 5, at the count the
+ * register holds whether or not its interrupt is on, as the hardware does.
+ * It raises the handlers in the processor's
+ * order, the capture ahead of TA0IV, unless a check holds them off for a
+ * while, as another handler or a flash write would.  Each check feeds the
+ * input a sequence of edges, in a process of its own so the handlers start
+ * from reset, and compares the captures and counts with the ones the
+ * firmware should make of them.
+ *
+ * Prints a line for each check and the reasons for any failure, and exits
+ * 1 if any check failed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "gpsdo.h"
+
+#if !PPS_VALIDATE && !PPS_OUT
+#error "the checks are of PPS_VALIDATE and PPS_OUT: build with either"
+#endif
+
+#define SECOND          10000000L       // oscillator counts
+#define PHASE           3000000L        // 1PPS falling edges, counts into each second
+#define WIDTH           1000000L        // 1PPS pulse, 100 ms
+#define SECONDS         6               // 1PPS pulses in a check
+#define MAX_EDGES       256
+#define MAX_CAPTURES    64
+#define OUT_SECONDS     60              // seconds of the 1PPS output checks
+
+// Timer 0's registers (timer.h)
+volatile uint16_t TA0CTL, TA0R, TA0IV;
+volatile uint16_t TA0CCTL0, TA0CCTL1, TA0CCTL2;
+volatile uint16_t TA0CCR0, TA0CCR1, TA0CCR2;
+
+void Timer_A (void);
+void Timer_A0 (void);
+
+static int verbose;
+static char reasons[1024];      // why the check failed, a line each
+static int fail;                // checks failed in this one
+
+static uint64_t now;            // oscillator counts since the timer started
+static uint64_t hold_from;      // the handlers are held off from then
+static uint64_t hold_to;        //   until then
+static int pin;                 // the 1PPS input
+
+static struct edge {
+    uint64_t t;
+    int level;
+} edges[MAX_EDGES];
+static int nedges, ei;
+
+static long captures[MAX_CAPTURES];     // 'capture' each time it was set
+static int ncaptures;
+
+static int out;                         // the 1PPS output
+static uint64_t rises[OUT_SECONDS + 1]; // its edges
+static uint64_t falls[OUT_SECONDS + 1];
+static int nrises, nfalls;
+
+void
+tx (char c)
+{
+    if (verbose)
+        putchar(c);
+}
+
+static void
+failed (const char *why)
+{
+    size_t n = strlen(reasons);
+
+    snprintf(reasons + n, sizeof(reasons) - n, "    %s\n", why);
+    fail++;
+}
+
+static void
+expect (const char *what, long got, long want)
+{
+    char why[96];
+
+    if (got != want) {
+        snprintf(why, sizeof(why), "%s %ld, expected %ld", what, got, want);
+        failed(why);
+    }
+}
+
+//
+// The 1PPS input
+//
+static void
+edge (uint64_t t, int level)
+{
+    edges[nedges].t = t;
+    edges[nedges].level = level;
+    nedges++;
+}
+
+// A pulse low from t for width counts, as the GPS's 1PPS comes
+static void
+pulse (uint64_t t, long width)
+{
+    edge(t, 0);
+    edge(t + width, 1);
+}
+
+// Pulses at phase counts into seconds from to to - 1
+static void
+pulses (int from, int to, long phase)
+{
+    int k;
+
+    for (k = from; k < to; k++)
+        pulse(k * SECOND + phase, WIDTH);
+}
+
+static int
+edge_order (const void *a, const void *b)
+{
+    const struct edge *x = a, *y = b;
+
+    return x->t < y->t ? -1 : x->t > y->t;
+}
+
+static void
+set_pin (int level)
+{
+    if (level == pin)
+        return;
+    pin = level;
+    if (level)
+        TA0CCTL0 |= CCI;
+    else
+        TA0CCTL0 &= ~CCI;
+    if ((TA0CCTL0 & CAP) && (TA0CCTL0 & (level ? CM_1 : CM_2))) {
+        if (TA0CCTL0 & CCIFG)
+            TA0CCTL0 |= COV;
+        TA0CCR0 = TA0R;
+        TA0CCTL0 |= CCIFG;
+    }
+}
+
+//
+// Timer 0
+//
+
+// The 1PPS output
+static void
+set_out (int level)
+{
+    if (level == out)
+        return;
+    out = level;
+    if (verbose)
+        printf("output %s at %llu\n", level ? "rises" : "falls",
+               (unsigned long long) now);
+    if (level && nrises <= OUT_SECONDS)
+        rises[nrises++] = now;
+    if (!level && nfalls <= OUT_SECONDS)
+        falls[nfalls++] = now;
+}
+
+// Compare 1 has matched: its output unit acts, and its flag is set
+static void
+compare1 (void)
+{
+    switch (TA0CCTL1 & OUTMOD_7) {
+    case OUTMOD_1:
+        set_out(1);
+        break;
+    case OUTMOD_5:
+        set_out(0);
+        break;
+    }
+    TA0CCTL1 |= CCIFG;
+}
+
+// The next count after now at which the timer is at r
+static uint64_t
+match (uint16_t r)
+{
+    return now + (uint16_t) (r - (uint16_t) now - 1) + 1;
+}
+
+// Run the handlers that are due, the capture first, then TA0IV's order
+static void
+interrupts (void)
+{
+    if (now >= hold_from && now < hold_to)
+        return;
+    for (;;) {
+        if ((TA0CCTL0 & (CCIE | CCIFG)) == (CCIE | CCIFG)) {
+            TA0CCTL0 &= ~CCIFG;
+            Timer_A0();
+            if (capture != 0) {
+                if (verbose)
+                    printf("capture %ld at %llu\n", capture, (unsigned long long) now);
+                if (ncaptures < MAX_CAPTURES)
+                    captures[ncaptures++] = capture;
+                capture = 0;
+            }
+        } else if ((TA0CCTL1 & (CCIE | CCIFG)) == (CCIE | CCIFG)) {
+            TA0CCTL1 &= ~CCIFG;
+            TA0IV = 2;
+            Timer_A();
+        } else if ((TA0CCTL2 & (CCIE | CCIFG)) == (CCIE | CCIFG)) {
+            TA0CCTL2 &= ~CCIFG;
+            TA0IV = 4;
+            Timer_A();
+        } else if ((TA0CTL & (TAIE | TAIFG)) == (TAIE | TAIFG)) {
+            TA0CTL &= ~TAIFG;
+            TA0IV = 10;
+            Timer_A();
+        } else {
+            break;
+        }
+    }
+}
+
+// Count up to t, stopping at each event
+static void
+run_to (uint64_t t)
+{
+    uint64_t next;
+
+    while (now < t) {
+        next = t;
+        if (((now | 0xffff) + 1) < next)
+            next = (now | 0xffff) + 1;
+        if (!(TA0CCTL1 & CAP) && match(TA0CCR1) < next)
+            next = match(TA0CCR1);
+        if (match(TA0CCR2) < next)
+            next = match(TA0CCR2);
+        if (ei < nedges && edges[ei].t < next)
+            next = edges[ei].t;
+        if (hold_from > now && hold_from < next)
+            next = hold_from;
+        if (hold_to > now && hold_to < next)
+            next = hold_to;
+
+        now = next;
+        TA0R = (uint16_t) now;
+        if (TA0R == 0)
+            TA0CTL |= TAIFG;
+        if (TA0R == TA0CCR1 && !(TA0CCTL1 & CAP))
+            compare1();
+        if (TA0R == TA0CCR2)
+            TA0CCTL2 |= CCIFG;
+        while (ei < nedges && edges[ei].t == now)
+            set_pin(edges[ei++].level);
+        interrupts();
+    }
+}
+
+// Start the timer as counter_init() does, the input at level, with the
+// check's edges in order
+static void
+timer_init (int level)
+{
+    qsort(edges, nedges, sizeof(edges[0]), edge_order);
+    TA0CTL = MC_2 | TAIE;
+#if PPS_VALIDATE
+    TA0CCTL0 = CM_3 | SCS | CAP | CCIE;
+#else
+    TA0CCTL0 = CM1 | SCS | CAP | CCIE;
+#endif
+#if PPS_OUT
+    TA0CCTL1 = OUTMOD_0;
+#else
+    TA0CCTL1 = 0;
+#endif
+    TA0CCTL2 = 0;
+    pin = level;
+    if (level)
+        TA0CCTL0 |= CCI;
+}
+
+//
+// The checks
+//
+
+#if PPS_VALIDATE
+// Every second captured, the first from the timer's start
+static void
+expect_seconds (int n, long first)
+{
+    int i;
+
+    expect("seconds captured", ncaptures, n);
+    if (ncaptures > 0)
+        expect("first capture", captures[0], first);
+    for (i = 1; i < ncaptures; i++)
+        expect("capture", captures[i], SECOND);
+}
+
+static void
+expect_pulses (int good, int narrow, int wide, int twice)
+{
+    expect("good", ppsstats.good, good);
+    expect("narrow", ppsstats.narrow, narrow);
+    expect("wide", ppsstats.wide, wide);
+    expect("twice", ppsstats.twice, twice);
+}
+
+// A 100 ms pulse each second
+static void
+check_pulse (void)
+{
+    pulses(0, SECONDS, PHASE);
+    timer_init(1);
+    run_to(SECONDS * SECOND);
+    expect_seconds(SECONDS, PHASE);
+    expect_pulses(SECONDS, 0, 0, 0);
+}
+
+// A glitch of half a microsecond half way through a second
+static void
+check_narrow (void)
+{
+    pulses(0, SECONDS, PHASE);
+    pulse(SECOND + SECOND / 2, 5);
+    timer_init(1);
+    run_to(SECONDS * SECOND);
+    expect_seconds(SECONDS, PHASE);
+    expect_pulses(SECONDS, 1, 0, 0);
+}
+
+// A glitch over before the handler is in: both edges are captured, the
+// second over the first, and the handler sees the input high again
+static void
+check_latency (void)
+{
+    pulses(0, SECONDS, PHASE);
+    pulse(SECOND + SECOND / 2, 5);
+    hold_from = SECOND + SECOND / 2 - 1;
+    hold_to = hold_from + 50;
+    timer_init(1);
+    run_to(SECONDS * SECOND);
+    expect_seconds(SECONDS, PHASE);
+    expect_pulses(SECONDS, 0, 0, 0);
+#ifdef ISR_STATS
+    expect("cov", isrstats.cov, 1);
+#endif
+}
+
+// The pulse the wrong way up: high for 100 ms, so each low is 900 ms
+static void
+check_polarity (void)
+{
+    int k;
+
+    for (k = 0; k < SECONDS; k++) {
+        edge(k * SECOND + PHASE, 1);
+        edge(k * SECOND + PHASE + WIDTH, 0);
+    }
+    timer_init(0);
+    run_to(SECONDS * SECOND);
+    expect_seconds(0, 0);
+    expect_pulses(0, 0, SECONDS - 1, 0);
+}
+
+// A second good pulse 400 ms after one
+static void
+check_twice (void)
+{
+    pulses(0, SECONDS, PHASE);
+    pulse(SECOND + PHASE + 4 * WIDTH, WIDTH);
+    timer_init(1);
+    run_to(SECONDS * SECOND);
+    expect_seconds(SECONDS, PHASE);
+    expect_pulses(SECONDS, 0, 0, 1);
+}
+
+//
+// A falling edge d counts after a wrap (before it, if d is negative), its
+// handler held off until after the wrap.  Either way the overflow is
+// pending when the capture is taken, and the wrap must go with the second
+// on the side of it the edge is.
+//
+static void
+race (long d)
+{
+    uint64_t t = (3 * SECOND / 65536 + 1) * 65536 + d;     // the fourth edge
+    long phase = t - 3 * SECOND;
+
+    pulses(0, SECONDS, phase);
+    hold_from = t - 15;
+    hold_to = t + 20;
+    timer_init(1);
+    run_to(SECONDS * SECOND);
+    expect_seconds(SECONDS, phase);
+    expect_pulses(SECONDS, 0, 0, 0);
+#ifdef ISR_STATS
+    expect("wrap", isrstats.wrap, 1);
+#endif
+}
+
+static void
+check_race_after (void)
+{
+    race(5);
+}
+
+static void
+check_race_before (void)
+{
+    race(-5);
+}
+#endif
+
+#if PPS_OUT
+// Each output edge, falling PPS_OUT_WIDTH wraps after it rose
+static void
+expect_widths (void)
+{
+    int i;
+
+    for (i = 0; i < nfalls && i < nrises; i++)
+        expect("output pulse", falls[i] - rises[i], PPS_OUT_WIDTH * 65536L);
+}
+
+//
+// The output runs from its first edge, at wrap 2, until the GPS 1PPS is
+// captured, then its first offset is stepped out at once: from the third
+// edge, each is on a 1PPS.  1,000,000 counts is 38528 past a whole number
+// of wraps, so the edges come in both halves of their wraps, and those in
+// the first half are armed from the compare half way through the wrap
+// before.
+//
+static void
+check_out_align (void)
+{
+    int k, first = 0, second = 0;
+
+    pulses(0, 8, PHASE);
+    timer_init(1);
+    run_to(8 * SECOND);
+    expect("output edges", nrises, 8);
+    if (nrises < 8)
+        return;
+    expect_widths();
+    expect("first output edge", rises[0], 2 * 65536L);
+    expect("second output edge", rises[1] - rises[0], SECOND);
+    for (k = 2; k < nrises; k++) {
+        expect("output edge - 1PPS", rises[k] - (k * SECOND + PHASE), 0);
+        if ((uint16_t) rises[k] < 0x8000)
+            first++;
+        else
+            second++;
+    }
+    if (first == 0 || second == 0)
+        failed("output edges not in both halves of their wraps");
+    expect("ppsout", ppsout, 0);
+    expect("ppsout steered", ppsout_steered, 1);
+}
+
+//
+// The 1PPS steps 200 us late.  The output follows it at PPS_OUT_SLEW counts
+// a second, then by a quarter of the offset each second, until it is on
+// the 1PPS again.
+//
+static void
+check_out_slew (void)
+{
+    long step = 2000;
+    long d;
+    int k, slewed = 0;
+
+    pulses(0, 10, PHASE);
+    pulses(10, OUT_SECONDS, PHASE + step);
+    timer_init(1);
+    run_to(OUT_SECONDS * SECOND);
+    expect("output edges", nrises, OUT_SECONDS);
+    if (nrises < OUT_SECONDS)
+        return;
+    expect_widths();
+    for (k = 3; k < nrises; k++) {
+        d = rises[k] - rises[k - 1] - SECOND;
+        if (d < -PPS_OUT_SLEW || d > PPS_OUT_SLEW)
+            expect("output second - 1 s", d, PPS_OUT_SLEW);
+        if (d == PPS_OUT_SLEW)
+            slewed++;
+    }
+    if (slewed < step / PPS_OUT_SLEW / 2)
+        expect("seconds slewed at PPS_OUT_SLEW", slewed, step / PPS_OUT_SLEW);
+    k = nrises - 1;
+    expect("last output edge - 1PPS", rises[k] - (k * SECOND + PHASE + step), 0);
+    expect("ppsout", ppsout, 0);
+}
+
+//
+// No 1PPS for three seconds: the output runs on a second at a time, not
+// steered, and picks the 1PPS up again
+//
+static void
+check_out_holdover (void)
+{
+    int k;
+
+    pulses(0, 5, PHASE);
+    pulses(8, 12, PHASE);
+    timer_init(1);
+    run_to(7 * SECOND + PHASE + 2 * WIDTH);
+    expect("ppsout steered, without the 1PPS", ppsout_steered, 0);
+    run_to(12 * SECOND);
+    expect("output edges", nrises, 12);
+    expect_widths();
+    for (k = 2; k < nrises; k++)
+        expect("output edge - 1PPS", rises[k] - (k * SECOND + PHASE), 0);
+    expect("ppsout steered", ppsout_steered, 1);
+}
+#endif
+
+static const struct check {
+    const char *name;
+    void (*run)(void);
+} checks[] = {
+#if PPS_VALIDATE
+    { "pps-pulse",          check_pulse },
+    { "pps-narrow",         check_narrow },
+    { "pps-latency",        check_latency },
+    { "pps-polarity",       check_polarity },
+    { "pps-twice",          check_twice },
+    { "pps-race-after",     check_race_after },
+    { "pps-race-before",    check_race_before },
+#endif
+#if PPS_OUT
+    { "out-align",          check_out_align },
+    { "out-slew",           check_out_slew },
+    { "out-holdover",       check_out_holdover },
+#endif
+    { NULL }
+};
+
+// Run a check in a process of its own.  Returns 1 if it failed.
+static int
+run (const struct check *c)
+{
+    pid_t pid;
+    int status;
+
+    fflush(stdout);
+    pid = fork();
+    if (pid < 0) {
+        perror("isr: fork");
+        exit(2);
+    }
+    if (pid == 0) {
+        c->run();
+        printf("%-18s %s\n", c->name, fail ? "FAIL" : "pass");
+        fputs(reasons, stdout);
+        fflush(stdout);
+        _exit(fail != 0);
+    }
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status)) {
+        printf("%-18s FAIL\n    crashed\n", c->name);
+        return 1;
+    }
+    return WEXITSTATUS(status) != 0;
+}
+
+static void
+usage (void)
+{
+    fprintf(stderr, "usage: isr [-v] [-c check]\n");
+    exit(2);
+}
+
+int
+main (int argc, char **argv)
+{
+    const struct check *c;
+    const char *only = NULL;
+    int failures = 0, total = 0;
+    int ch;
+
+    while ((ch = getopt(argc, argv, "vc:")) != -1) {
+        switch (ch) {
+        case 'v':
+            verbose = 1;
+            break;
+        case 'c':
+            only = optarg;
+            break;
+        default:
+            usage();
+        }
+    }
+
+    for (c = checks; c->name; c++) {
+        if (only && strcmp(only, c->name) != 0)
+            continue;
+        total++;
+        failures += run(c);
+    }
+    if (total == 0) {
+        fprintf(stderr, "isr: unknown check %s\n", only);
+        exit(2);
+    }
+    printf("%d of %d checks failed\n", failures, total);
+    return failures != 0;
+}
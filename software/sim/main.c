@@ -0,0 +1,162 @@
+/*
+ * sim: run the pid2 control loop against a simulated oscillator and GPS
+ *
+ * Copyright 2014-2017 Glen Overby
+ * 
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * usage: sim [-v] [-p profile] [-d duty] [-t temperature] [-s seconds]
+ *            [-j jitter-ns] [-g seconds] [-n seed] [-r file] [-k clock]
+ *        sim -b [-s seconds] [-c baseline.csv] [-k clock]
+ *
+ *  -v  print the firmware's serial output
+ *  -p  oscillator profile (default isotemp)
+ *  -d  PWM duty cycle at power on (default PWM_START)
+ *  -t  temperature scenario: none, diurnal, step or ramp
+ *  -s  seconds to run (default 6 hours, 1 day for -b)
+ *  -j  GPS 1PPS jitter, ns rms (default 20)
+ *  -g  inject a glitch every this many seconds, cycling through a missed
+ *      1PPS edge, a doubled edge, and a capture that races the overflow
+ *  -n  random number seed
+ *  -r  write the counts given to the firmware to a file, for replay
+ *  -k  PWM clock model: ideal (default), dco, or osc (OSC_CLOCK)
+ *  -b  run the lock time and stability benchmark, writing CSV to stdout
+ *  -c  compare the benchmark with an earlier run's CSV, on stderr
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "gpsdo.h"
+#include "pid2.h"
+#include "sim.h"
+
+static void
+usage (void)
+{
+    fprintf(stderr, "usage: sim [-v] [-p profile] [-d duty] [-t temperature] [-s seconds]\n"
+                    "           [-j jitter-ns] [-g seconds] [-n seed] [-r file] [-k clock]\n"
+                    "       sim -b [-s seconds] [-c baseline.csv] [-k clock]\n");
+    exit(2);
+}
+
+int
+main (int argc, char **argv)
+{
+    struct sim s;
+    const struct osc *osc = &osc_profiles[0];
+    long seconds = 0;
+    long every = 0;             // glitch interval
+    long glitches;
+    unsigned long seed = 1;
+    double jitter = 20;
+    unsigned int duty = PWM_START;
+    int temp = T_NONE;
+    int pwmclock = K_IDEAL;
+    int verbose = 0;
+    int bench = 0;
+    const char *baseline = NULL;
+    const char *record = NULL;
+    int ch;
+
+    while ((ch = getopt(argc, argv, "vp:d:t:s:j:g:n:r:bc:k:")) != -1) {
+        switch (ch) {
+        case 'v':
+            verbose = 1;
+            break;
+        case 'p':
+            for (osc = osc_profiles; osc->name; osc++)
+                if (strcmp(osc->name, optarg) == 0)
+                    break;
+            if (osc->name == NULL) {
+                fprintf(stderr, "sim: unknown profile %s\n", optarg);
+                exit(2);
+            }
+            break;
+        case 'd':
+            duty = strtoul(optarg, NULL, 0);
+            break;
+        case 't':
+            for (temp = 0; temp_names[temp]; temp++)
+                if (strcmp(temp_names[temp], optarg) == 0)
+                    break;
+            if (temp_names[temp] == NULL) {
+                fprintf(stderr, "sim: unknown temperature scenario %s\n", optarg);
+                exit(2);
+            }
+            break;
+        case 's':
+            seconds = atol(optarg);
+            break;
+        case 'j':
+            jitter = atof(optarg);
+            break;
+        case 'g':
+            every = atol(optarg);
+            break;
+        case 'n':
+            seed = strtoul(optarg, NULL, 0);
+            break;
+        case 'r':
+            record = optarg;
+            break;
+        case 'k':
+            for (pwmclock = 0; pwmclock_names[pwmclock]; pwmclock++)
+                if (strcmp(pwmclock_names[pwmclock], optarg) == 0)
+                    break;
+            if (pwmclock_names[pwmclock] == NULL) {
+                fprintf(stderr, "sim: unknown PWM clock %s\n", optarg);
+                exit(2);
+            }
+            break;
+        case 'b':
+            bench = 1;
+            break;
+        case 'c':
+            baseline = optarg;
+            break;
+        default:
+            usage();
+        }
+    }
+
+    if (bench)
+        return sim_bench(seconds ? seconds : 86400, baseline, pwmclock);
+    if (seconds == 0)
+        seconds = 6 * 3600;
+
+    sim_init(&s, osc, seed);
+    s.jitter = jitter * 1e-9;
+    s.temp = temp;
+    s.pwmclock = pwmclock;
+    s.verbose = verbose;
+    if (record && (s.record = fopen(record, "w")) == NULL) {
+        perror(record);
+        exit(1);
+    }
+
+    glitches = sim_run(&s, duty, seconds, every);
+    if (s.record)
+        fclose(s.record);
+    if (verbose)
+        putchar('\n');
+
+    printf("seconds %ld state %d fast-lock %ld slow %ld slow-lock %ld fallbacks %ld glitches %ld",
+           s.sec, state, s.fastlock, s.slow, s.slowlock, s.fallbacks, glitches);
+#if CAPTURE_FILTER
+    printf(" outliers %u", outliers);
+#endif
+    printf("\n");
+    return 0;
+}
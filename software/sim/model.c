@@ -0,0 +1,431 @@
+/*
+ * model.c - Oscillator and GPS model, and the board interface for pid2
+ *
+ * Copyright 2014-2017 Glen Overby
+ * 
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * The oscillator runs at 10mhz + kv * (filtered duty cycle - center) plus
+ * noise.  Its phase is integrated SUBSTEPS times a second, and the 1PPS count
+ * is the number of whole cycles between (jittered) edges, as the counter
+ * sees it.  The firmware's main loop runs once per step, and the 1PPS
+ * interrupt between steps.
+ *
+ * The PWM can be modeled as the filter sees it (K_DCO and K_OSC).  The
+ * output's rise and fall times differ, which adds PWM_SKEW seconds of high
+ * to each cycle, an offset in proportion to the PWM frequency; and the
+ * filter passes some of the ripple, a triangle of D(1-D)/(f tau) of full
+ * scale peak to peak, which frequency modulates the oscillator and so moves
+ * the phase the counter captures.  Timer 1 on the DCO runs at CPU_MHZ /
+ * PWM_PERIOD, drifting DCO_TEMPCO per degree, with its own phase; on the
+ * oscillator (OSC_CLOCK), at the oscillator's frequency / PWM_PERIOD, in
+ * step with it.
+ *
+ * Built with -DDUAL_PWM=1, the filter is the dual PWM's faster one, and
+ * with -DSPI_DAC=1 it is the DAC's output filter, with no PWM to model
+ * (-k is ignored).
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "gpsdo.h"
+#include "pid2.h"
+#include "sim.h"
+
+struct sim *sim;                // the simulation the board interface uses
+
+//
+// Oscillator profiles.  kv comes from P_FACTOR_FAST: PWM steps per Hz.
+// The others are the same oscillator with a tuning slope the firmware's
+// gains were not set for, and with more noise, temperature sensitivity
+// and aging.
+//
+const struct osc osc_profiles[] = {
+    //  name            kv              center  tau     noise   walk    tempco  aging
+    { "isotemp",        1.0 / 2500,     30000,  0.2,    1e-4,   1e-5,   5e-4,   1e-3 },
+    { "isotemp-lowkv",  0.7 / 2500,     20000,  0.2,    1e-4,   1e-5,   5e-4,   1e-3 },
+    { "isotemp-highkv", 1.4 / 2500,     42000,  0.2,    1e-4,   1e-5,   5e-4,   1e-3 },
+    { "isotemp-noisy",  1.0 / 2500,     30000,  0.2,    1e-3,   5e-5,   2e-3,   5e-3 },
+    { NULL }
+};
+
+const char *temp_names[] = { "none", "diurnal", "step", "ramp", NULL };
+const char *pwmclock_names[] = { "ideal", "dco", "osc", NULL };
+
+#define PWM_SKEW        10e-9   // seconds
+#define DCO_TEMPCO      1e-3    // fraction per degree C
+
+// The dual PWM (DUAL_PWM) is fast enough for a fast filter
+#if DUAL_PWM
+#define PWM_PERIOD      DUAL_PERIOD
+#define DUAL_TAU        0.02    // seconds
+#else
+#define PWM_PERIOD      65536
+#endif
+#define DAC_TAU         0.001   // seconds: the SPI DAC's output filter
+
+//
+// Board interface: what the counter interrupt handlers and port pins
+// provide to the firmware.
+//
+volatile uint16_t wraps = 0;
+volatile uint16_t ppswraps = 0;
+volatile long capture = 0;
+volatile char lost = 0;
+
+// The phase lock's messages (PLL) are followed in the serial output
+void
+tx (char c)
+{
+    static char line[8];        // the start of the line
+    static int n;
+
+    if (c == '\r')
+        return;
+    if (sim->verbose)
+        putchar(c);
+    if (c != '\n') {
+        if (n < (int) sizeof(line) - 1)
+            line[n++] = c;
+        return;
+    }
+    line[n] = '\0';
+    n = 0;
+    if (strncmp(line, "** PLL", 6) == 0)
+        sim->pll = line[6] == '\0' ? sim->sec : -1;
+}
+
+void
+pwm_set (unsigned int duty)
+{
+    sim->duty = duty;
+}
+
+// Solid yellow and solid green are FAST and SLOW with no error
+void
+ledstate (int blue, int green, int yellow)
+{
+    if (yellow == -1 && sim->fastlock < 0)
+        sim->fastlock = sim->sec;
+    if (green == -1 && sim->slowlock < 0)
+        sim->slowlock = sim->sec;
+}
+
+int
+osc_cold (void)
+{
+    return sim->cold;
+}
+
+int
+gps_nolock (void)
+{
+    return sim->nolock;
+}
+
+#if TUNABLE
+// Tuned (or set) gains, kept for the run
+static struct tune saved;
+static int nsaved;
+
+int
+tune_load (struct tune *t)
+{
+    if (nsaved)
+        *t = saved;
+    return nsaved;
+}
+
+void
+tune_save (const struct tune *t)
+{
+    saved = *t;
+    nsaved = 1;
+}
+#endif
+
+//
+// Random numbers: xorshift64*, and normally distributed by Box-Muller
+//
+static double
+sim_random (struct sim *s)
+{
+    s->rng ^= s->rng >> 12;
+    s->rng ^= s->rng << 25;
+    s->rng ^= s->rng >> 27;
+    return ((s->rng * 0x2545F4914F6CDD1DULL) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+double
+sim_gauss (struct sim *s)
+{
+    double u = sim_random(s);
+    double v = sim_random(s);
+
+    return sqrt(-2 * log(u + 1e-300)) * cos(2 * M_PI * v);
+}
+
+void
+sim_init (struct sim *s, const struct osc *osc, uint64_t seed)
+{
+    s->osc = *osc;
+#if DUAL_PWM
+    s->osc.tau = DUAL_TAU;
+#endif
+#if SPI_DAC
+    s->osc.tau = DAC_TAU;
+#endif
+    s->jitter = 0;
+    s->temp = T_NONE;
+    s->pwmclock = K_IDEAL;
+    s->verbose = 0;
+    s->nopps = s->noosc = s->cold = s->nolock = 0;
+    s->rng = seed * 0x9E3779B97F4A7C15ULL + 1;
+    s->sec = 0;
+    s->phase = sim_random(s) * 10000000;
+    s->edge = s->phase;
+    s->carry = 0;
+    wraps = ppswraps = (uint16_t) fmod(floor(s->phase / 65536), 65536);
+    capture = 0;
+    lost = 0;
+    s->stopped = 0;
+    s->pwmphase = 0;
+    s->duty = 1;
+    s->v = s->duty;
+    s->walkf = 0;
+    s->freq = 10000000;
+    s->tie = 0;
+    s->laststate = START;
+    s->fastlock = -1;
+    s->slow = -1;
+    s->slowlock = -1;
+    s->pll = -1;
+    s->fallbacks = 0;
+    s->errors = 0;
+    s->x = NULL;
+    s->nx = 0;
+    s->record = NULL;
+#if TUNABLE
+    nsaved = 0;
+#endif
+    sim = s;
+}
+
+// Follow the firmware's state changes
+static void
+track (struct sim *s)
+{
+    if (state == s->laststate)
+        return;
+    if (state == SLOW && s->slow < 0)
+        s->slow = s->sec;
+    if (s->laststate == SLOW && state == FASTINIT)
+        s->fallbacks++;
+    if (state > CHECKERRORS && state < GOOD)
+        s->errors++;
+    s->laststate = state;
+}
+
+// Temperature, degrees C from where the oscillator was set up
+static double
+temperature (struct sim *s, double t)
+{
+    switch (s->temp) {
+    case T_DIURNAL:
+        return 3 * sin(2 * M_PI * t / 86400);
+    case T_STEP:
+        return t < 4 * 3600 ? 0 : 5;
+    case T_RAMP:
+        t = t < 2 * 3600 ? 0 : t > 8 * 3600 ? 6 * 3600 : t - 2 * 3600;
+        return t / 3600;
+    }
+    return 0;
+}
+
+// PWM frequency, Hz, or 0 if it doesn't run (or is an SPI DAC)
+static double
+pwm_freq (struct sim *s, double t)
+{
+#if SPI_DAC
+    return 0;
+#endif
+    switch (s->pwmclock) {
+    case K_DCO:
+        return CPU_MHZ * 1e6 / PWM_PERIOD * (1 + DCO_TEMPCO * temperature(s, t));
+    case K_OSC:
+        return s->noosc ? 0 : s->freq / PWM_PERIOD;
+    }
+    return 0;
+}
+
+// The ripple's effect on the oscillator's phase, cycles, at the given phase
+static double
+ripple (struct sim *s, double phase)
+{
+    double f = pwm_freq(s, s->sec);
+    double d = s->duty / 65536.0;
+    double a, theta;
+
+    if (f == 0 || s->noosc)
+        return 0;
+    a = s->osc.kv * 65536 * d * (1 - d) / (f * s->osc.tau) / 2;  // Hz, peak
+    if (s->pwmclock == K_OSC)
+        theta = phase / PWM_PERIOD;
+    else
+        theta = s->pwmphase + f * (phase - s->phase) / s->freq;
+    return a / (2 * M_PI * f) * sin(2 * M_PI * theta);
+}
+
+// Advance the oscillator by dt seconds
+static void
+step (struct sim *s, double dt)
+{
+    double f;
+
+    double t = s->sec;          // temperature and aging change slowly
+    double u = s->duty;         // PWM duty cycle as the filter sees it
+
+    if (s->pwmclock != K_IDEAL) {
+        f = pwm_freq(s, t);
+        u += PWM_SKEW * f * 65536;
+        s->pwmphase = fmod(s->pwmphase + f * dt, 1.0);
+    }
+    s->v += (u - s->v) * (1 - exp(-dt / s->osc.tau));
+    s->walkf += s->osc.walk * sqrt(dt) * sim_gauss(s);
+    s->freq = 10000000 + s->osc.kv * (s->v - s->osc.center) + s->walkf
+            + s->osc.noise * sim_gauss(s)
+            + s->osc.tempco * temperature(s, t)
+            + s->osc.aging * t / 86400;
+    f = s->noosc ? 0 : s->freq;
+    s->phase += f * dt;
+    s->tie += (f - 10000000) / 10000000 * dt;
+    wraps = (uint16_t) fmod(floor(s->phase / 65536), 65536);
+
+    // the watchdogs in counter.c
+    if (s->noosc) {
+        s->stopped += dt;
+        if (s->stopped >= OSC_HOLDOFF / 1000.0)
+            lost |= LOST_OSC;
+    } else {
+        s->stopped = 0;
+        lost &= ~LOST_OSC;
+    }
+    if (s->phase - s->edge >= PPS_HOLDOFF * 10000000.0)
+        lost |= LOST_PPS;
+}
+
+// The 1PPS interrupt: capture the counter at the given phase
+static void
+edge (struct sim *s, double phase)
+{
+    long c;
+
+    phase += ripple(s, phase);
+    c = (long) (floor(phase) - floor(s->edge)) + s->carry;
+
+    s->carry = 0;
+    s->edge = phase;
+    ppswraps = (uint16_t) fmod(floor(phase / 65536), 65536);
+    if (phase > s->phase)
+        wraps = ppswraps;       // a late edge: the counter has got there too
+    capture = c;
+    lost &= ~LOST_PPS;
+}
+
+// One pass of the main loop, as pid2/main.c
+static void
+loop (struct sim *s)
+{
+    long c;
+
+    control_poll();
+    track(s);
+    if (capture != 0) {
+        c = capture;
+        capture = 0;
+        if (s->record)
+            fprintf(s->record, "%ld\n", c);
+        control_pps(c);
+        track(s);
+    }
+}
+
+//
+// A watchdog reset: the counter starts over, and main() resumes the firmware
+// from the state it saved at the last 1PPS.
+//
+void
+sim_reset (struct sim *s)
+{
+    struct resume r;
+
+    control_save(&r);
+    s->edge = s->phase;
+    s->carry = 0;
+    ppswraps = wraps;
+    capture = 0;
+    lost = 0;
+    control_resume(&r);
+}
+
+//
+// Simulate one second: SUBSTEPS passes of the main loop, then the 1PPS edge.
+// The main loop takes the edge's count at the start of the next second.
+//
+void
+sim_second (struct sim *s, int glitch)
+{
+    int i;
+    double j;
+
+    for (i = 0; i < SUBSTEPS; i++) {
+        loop(s);
+        step(s, 1.0 / SUBSTEPS);
+        if (glitch == G_DOUBLE && i == SUBSTEPS / 2 && !s->nopps)
+            edge(s, s->phase);
+    }
+    s->sec++;
+    if (s->sec < s->nx)
+        s->x[s->sec] = s->tie;
+
+    if (glitch == G_MISSED || s->nopps)
+        return;
+    if (glitch == G_RACE) {
+        s->carry = -65536;      // the next second is short what this one gained
+        s->edge -= 65536;
+    }
+    j = s->jitter * sim_gauss(s);
+    edge(s, s->noosc ? s->phase : s->phase + s->freq * j);
+}
+
+//
+// Start the firmware at the given duty cycle and run for the given number
+// of seconds, injecting a glitch every so many seconds (if not 0).
+// Returns the number of glitches.
+//
+long
+sim_run (struct sim *s, uint16_t duty, long seconds, long every)
+{
+    long glitches = 0;
+    int glitch;
+
+    control_init(duty);
+    while (s->sec < seconds) {
+        glitch = G_NONE;
+        if (every && s->sec > 0 && s->sec % every == 0)
+            glitch = G_MISSED + glitches++ % 3;
+        sim_second(s, glitch);
+    }
+    return glitches;
+}
@@ -0,0 +1,164 @@
+/*
+ * pll: check that pid2's phase lock removes a frequency offset
+ *
+ * Copyright 2014-2017 Glen Overby
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * usage: pll [-v] [-n runs]
+ *
+ *  -v  print the firmware's serial output
+ *  -n  runs, with different seeds (default 3)
+ *
+ * Each run brings a quiet isotemp, without random walk or aging, to SLOW
+ * lock and waits for the phase lock to take over.  The oscillator is then
+ * stepped STEP Hz off.  Over the last of SETTLE_TAUS of the loop's tau, its
+ * phase at the 1PPS, as the counter sees it, must average within LIMIT
+ * counts of where it was when the phase lock took over, with the lock held
+ * all along.  A type 2 loop takes a constant frequency offset out of its
+ * phase; one whose integral gain had rounded to 0 would be left STEP Hz /
+ * its proportional gain behind, about 200 counts at the largest tau.
+ *
+ * The phase is taken from the captures rather than the model's time error,
+ * which drifts from them by about 0.001 counts a second after a day or so,
+ * as the oscillator's phase, a double, grows.
+ *
+ * Built with -DPLL=1 and the tau to check (make pll: PLL_TAU 30000, the
+ * largest pll_tau of 10000 at BW_MAX).  Prints a line for each run and
+ * the reasons for any failure, and exits 1 if any run failed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+#include "gpsdo.h"
+#include "pid2.h"
+#include "sim.h"
+
+#if !PLL
+#error "pll checks the phase lock: build with -DPLL=1"
+#endif
+
+#define JITTER          20e-9   // GPS 1PPS jitter, seconds rms
+#define LOCK_LIMIT      3600    // seconds allowed for the first SLOW lock
+#define HANDOVER        1800    // seconds allowed after it for the phase lock
+#define STEP            0.01    // Hz, 1e-9
+#define SETTLE_TAUS     10      // taus from the step to the end of the check
+#define LIMIT           5       // counts
+
+static int verbose;
+static char reasons[512];       // why the run failed, a line each
+
+static int
+failed (int fail, const char *why)
+{
+    size_t n = strlen(reasons);
+
+    snprintf(reasons + n, sizeof(reasons) - n, "    %s\n", why);
+    return fail + 1;
+}
+
+// Run once.  Returns the number of checks that failed.
+static int
+run (unsigned long seed)
+{
+    struct sim s;
+    struct osc quiet = osc_profiles[0];
+    char why[96];
+    long t, left = -1, settle = (long) SETTLE_TAUS * PLL_TAU;
+    double ref, sum = 0, off;   // phase at the 1PPS, cycles
+    int fail = 0;
+
+    reasons[0] = '\0';
+    quiet.walk = 0;
+    quiet.aging = 0;
+    sim_init(&s, &quiet, seed);
+    s.jitter = JITTER;
+    s.verbose = verbose;
+    control_init(PWM_START);
+
+    for (t = 0; t < LOCK_LIMIT && s.slowlock < 0; t++)
+        sim_second(&s, G_NONE);
+    for (t = 0; t < HANDOVER && s.pll < 0; t++)
+        sim_second(&s, G_NONE);
+    if (s.pll < 0) {
+        printf("pll %4lu  no phase lock: FAIL\n", seed);
+        return 1;
+    }
+    ref = s.edge - 10000000.0 * s.sec;
+
+    // the step, and the phase averaged over the last tau
+    s.walkf += STEP;
+    for (t = 0; t < settle; t++) {
+        sim_second(&s, G_NONE);
+        if (left < 0 && (state != SLOW || s.pll < 0))
+            left = t + 1;
+        if (t >= settle - PLL_TAU)
+            sum += s.edge - 10000000.0 * s.sec;
+    }
+    off = sum / PLL_TAU - ref;
+
+    if (left >= 0) {
+        snprintf(why, sizeof(why), "lost the phase lock %ld seconds after the step",
+                 left);
+        fail = failed(fail, why);
+    }
+    if (fabs(off) > LIMIT) {
+        snprintf(why, sizeof(why), "phase %.1f counts from the lock, allowed %d",
+                 off, LIMIT);
+        fail = failed(fail, why);
+    }
+
+    printf("pll %4lu  tau %ld  locked at %5ld s  phase %+7.1f counts  %s\n",
+           seed, (long) PLL_TAU, s.pll, off, fail ? "FAIL" : "pass");
+    fputs(reasons, stdout);
+    return fail;
+}
+
+static void
+usage (void)
+{
+    fprintf(stderr, "usage: pll [-v] [-n runs]\n");
+    exit(2);
+}
+
+int
+main (int argc, char **argv)
+{
+    long runs = 3;
+    long n, failures = 0;
+    int ch;
+
+    while ((ch = getopt(argc, argv, "vn:")) != -1) {
+        switch (ch) {
+        case 'v':
+            verbose = 1;
+            break;
+        case 'n':
+            runs = atol(optarg);
+            break;
+        default:
+            usage();
+        }
+    }
+    if (runs <= 0)
+        usage();
+
+    for (n = 1; n <= runs; n++)
+        if (run(n))
+            failures++;
+    printf("%ld of %ld runs failed\n", failures, runs);
+    return failures != 0;
+}
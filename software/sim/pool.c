@@ -0,0 +1,152 @@
+/*
+ * pool.c - Simulator runs in worker processes, for the sweep and the tuner
+ *
+ * Copyright 2014-2017 Glen Overby
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Run k of every set of gains has the same conditions: a random power on
+ * duty cycle, GPS jitter of 5 to 100 ns and temperature scenario, and the
+ * same noise, so the gains are compared on equal terms.
+ *
+ * The firmware keeps its state in file-scope variables, so each worker is
+ * a process of its own.  The workers take the next run from a counter in
+ * shared memory until there are none left, so a worker that draws short
+ * runs takes more of them.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "gpsdo.h"
+#include "pid2.h"
+#include "pool.h"
+
+struct gains gains;             // the gains control.c is built with
+
+const long taus[NTAUS] = { 100, 1000, 10000 };
+
+// Shared by the workers
+struct shared {
+    long next;                  // next run to take
+    long done;                  // runs finished
+    struct run runs[];
+};
+
+// splitmix64: conditions for run k
+static uint64_t
+mix (uint64_t *x)
+{
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static void
+run (const struct pool *p, struct run *r, const struct gains *g, long k)
+{
+    struct sim s;
+    uint64_t x = k;
+    unsigned int duty = 1 + mix(&x) % 65535;
+    double jitter = 5 + (mix(&x) >> 11) * (95.0 / 9007199254740992.0);
+    int temp = mix(&x) % (T_RAMP + 1);
+    int i;
+
+    gains = *g;
+    sim_init(&s, p->osc, k + 1);
+    s.jitter = jitter * 1e-9;
+    s.temp = temp;
+    s.nx = p->seconds + 1;
+    s.x = calloc(s.nx, sizeof(double));
+    if (s.x == NULL) {
+        perror("pool");
+        exit(1);
+    }
+
+    sim_run(&s, duty, p->seconds, 0);
+
+    r->slowlock = s.slowlock;
+    r->fallbacks = s.fallbacks;
+    for (i = 0; i < NTAUS; i++)
+        r->adev[i] = s.slow < 0 ? -1 : adev(s.x + s.slow, s.nx - s.slow, taus[i]);
+    free(s.x);
+}
+
+static void
+worker (const struct pool *p, struct shared *sh, const struct gains *g,
+        long njobs, int report)
+{
+    long j;
+
+    while ((j = __atomic_fetch_add(&sh->next, 1, __ATOMIC_RELAXED)) < njobs) {
+        run(p, &sh->runs[j], &g[j / p->nruns], j % p->nruns);
+        __atomic_fetch_add(&sh->done, 1, __ATOMIC_RELAXED);
+        if (report)
+            fprintf(stderr, "\r%ld/%ld", __atomic_load_n(&sh->done, __ATOMIC_RELAXED), njobs);
+    }
+}
+
+//
+// Run each of the ngains sets of gains p->nruns times.  The results for
+// g[i] are runs[i * p->nruns] on.
+//
+void
+pool_run (const struct pool *p, const struct gains *g, long ngains,
+          struct run *runs)
+{
+    long njobs = ngains * p->nruns;
+    size_t size = sizeof(struct shared) + njobs * sizeof(struct run);
+    struct shared *sh;
+    long i;
+    int status = 0, st;
+    pid_t pid;
+
+    sh = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (sh == MAP_FAILED) {
+        perror("pool");
+        exit(1);
+    }
+    sh->next = sh->done = 0;
+
+    fflush(stdout);
+    fflush(stderr);
+    for (i = 0; i < (p->workers < 1 ? 1 : p->workers); i++) {
+        pid = fork();
+        if (pid < 0) {
+            perror("pool");
+            exit(1);
+        }
+        if (pid == 0) {
+            worker(p, sh, g, njobs, i == 0 && p->progress);
+            _exit(0);
+        }
+    }
+    while (wait(&st) > 0)
+        if (!WIFEXITED(st) || WEXITSTATUS(st) != 0)
+            status = 1;
+    if (p->progress)
+        fprintf(stderr, "\n");
+    if (status || sh->done != njobs) {
+        fprintf(stderr, "pool: a worker failed\n");
+        exit(1);
+    }
+
+    memcpy(runs, sh->runs, njobs * sizeof(struct run));
+    munmap(sh, size);
+}
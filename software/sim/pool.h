@@ -0,0 +1,46 @@
+/*
+ * pool.h - Simulator runs in worker processes, for the sweep and the tuner
+ *
+ * Copyright 2014-2017 Glen Overby
+ * 
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+#include "gains.h"
+#include "sim.h"
+
+#define NTAUS   3
+
+extern const long taus[NTAUS];  // Allan deviation at 100, 1000 and 10000 s
+
+struct run {
+    long slowlock;              // second SLOW first made no adjustment, or -1
+    long fallbacks;             // SLOW -> FASTINIT transitions
+    double adev[NTAUS];         // from the time SLOW was entered, or -1
+};
+
+struct pool {
+    const struct osc *osc;
+    long seconds;               // seconds in each run
+    long nruns;                 // runs of each set of gains
+    long workers;               // worker processes
+    int progress;               // show the runs done on stderr
+};
+
+void pool_run (const struct pool *p, const struct gains *g, long ngains,
+               struct run *runs);
+
+#endif /* POOL_H */
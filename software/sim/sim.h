@@ -0,0 +1,113 @@
+/*
+ * sim.h - Host simulator for the pid2 control loop
+ *
+ * Copyright 2014-2017 Glen Overby
+ * 
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define SUBSTEPS        10      // model steps (and main loop passes) per second
+
+// Oscillator model
+struct osc {
+    const char *name;
+    double kv;                  // Hz per PWM step
+    double center;              // PWM duty cycle for 10mhz
+    double tau;                 // PWM low-pass filter time constant, seconds
+    double noise;               // white frequency noise, Hz rms
+    double walk;                // random walk frequency noise, Hz per root second
+    double tempco;              // Hz per degree C
+    double aging;               // Hz per day
+};
+
+// Temperature scenarios
+#define T_NONE          0       // constant
+#define T_DIURNAL       1       // +-3C daily swing
+#define T_STEP          2       // +5C step at four hours
+#define T_RAMP          3       // +1C an hour from two to eight hours
+
+
+// PWM clock models
+#define K_IDEAL         0       // the duty cycle alone sets the control voltage
+#define K_DCO           1       // timer 1 on the DCO, which drifts with temperature
+#define K_OSC           2       // timer 1 on the oscillator (OSC_CLOCK)
+
+// Glitches in the 1PPS captures
+#define G_NONE          0
+#define G_MISSED        1       // a 1PPS edge is missed: a two second count
+#define G_DOUBLE        2       // an extra edge in the middle of a second
+#define G_RACE          3       // a capture races the counter overflow
+
+struct sim {
+    struct osc osc;
+    double jitter;              // GPS 1PPS jitter, seconds rms
+    int temp;                   // temperature scenario
+    int pwmclock;               // PWM clock model
+    uint64_t rng;               // random number state
+    int verbose;                // print the firmware's output
+    FILE *record;               // write the counts to this, if not NULL
+
+    // faults, set between seconds
+    int nopps;                  // no 1PPS edges from the GPS
+    int noosc;                  // the oscillator has stopped
+    int cold;                   // the oscillator's cold pin
+    int nolock;                 // the GPS's no lock pin
+
+    // model state
+    long sec;                   // seconds simulated
+    double phase;               // oscillator phase, cycles
+    double freq;                // oscillator frequency, Hz
+    double v;                   // filtered PWM duty cycle
+    double walkf;               // random walk frequency offset, Hz
+    double edge;                // phase at the last 1PPS capture
+    long carry;                 // count to add to the next capture (G_RACE)
+    unsigned int duty;          // PWM duty cycle set by the firmware
+    double tie;                 // time error of the oscillator, seconds
+    double stopped;             // seconds the oscillator has been stopped
+    double pwmphase;            // PWM cycles, less whole ones (K_DCO)
+
+    // results
+    char laststate;             // firmware state at the last check
+    long fastlock;              // second FAST first had no error, or -1
+    long slow;                  // second SLOW was first entered, or -1
+    long slowlock;              // second SLOW first made no adjustment, or -1
+    long pll;                   // second the phase lock took over, or -1 (PLL)
+    long fallbacks;             // SLOW -> FASTINIT transitions
+    long errors;                // error states entered
+    double *x;                  // time error at each second, if not NULL
+    long nx;                    //   seconds x has room for
+};
+
+extern struct sim *sim;
+
+void sim_init (struct sim *s, const struct osc *osc, uint64_t seed);
+void sim_second (struct sim *s, int glitch);
+void sim_reset (struct sim *s);
+long sim_run (struct sim *s, uint16_t duty, long seconds, long every);
+double sim_gauss (struct sim *s);
+
+extern const struct osc osc_profiles[];
+extern const char *temp_names[];
+extern const char *pwmclock_names[];
+
+// Lock time and stability benchmark (bench.c)
+double adev (const double *x, long n, long m);
+int sim_bench (long seconds, const char *baseline, int pwmclock);
+
+#endif /* SIM_H */
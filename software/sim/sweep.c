@@ -0,0 +1,255 @@
+/*
+ * sweep: Monte Carlo sweep of pid2's SLOW gains in the simulator
+ *
+ * Copyright 2014-2017 Glen Overby
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * usage: sweep [-p profile] [-s seconds] [-n runs] [-w workers]
+ *              [-P list] [-I list] [-B list] [-E list]
+ *
+ *  -p  oscillator profile (default isotemp)
+ *  -s  seconds in each run (default 2 days)
+ *  -n  runs of each combination of gains (default 8)
+ *  -w  worker processes (default one per processor)
+ *  -P  P_FACTOR_SLOW values, comma separated (default 10,25,50,75,100)
+ *  -I  I_FACTOR_SLOW values (default 5,10,25,50)
+ *  -B  P_ERRORBAND_SLOW values (default 0,1,2)
+ *  -E  I_ERRORBAND_SLOW values (default 0,1,2)
+ *
+ * Run k of every combination has the same conditions (see pool.c), so the
+ * combinations are compared on equal terms.
+ *
+ * Writes a CSV line for each combination to stdout: the gains, the runs
+ * that reached SLOW lock, the mean time to SLOW lock (a run that never
+ * locked counts as the whole run), total SLOW -> FAST fallbacks, the mean
+ * Allan deviation at 100 and 1000 seconds, and whether the combination is
+ * on the Pareto front of lock time against the 1000 second deviation.
+ * The front is also printed on stderr.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "gpsdo.h"
+#include "pid2.h"
+#include "pool.h"
+
+#define MAXVALUES       16
+
+struct list {
+    int n;
+    int16_t v[MAXVALUES];
+};
+
+struct combo {
+    struct gains g;
+    long locked;
+    double lock;
+    long fallbacks;
+    double adev100;
+    double adev1000;
+    int pareto;
+};
+
+static struct pool pool = { osc_profiles, 2 * 86400, 8 };
+
+static void
+parse (struct list *l, char *s)
+{
+    char *t;
+
+    l->n = 0;
+    for (t = strtok(s, ","); t; t = strtok(NULL, ",")) {
+        if (l->n == MAXVALUES) {
+            fprintf(stderr, "sweep: more than %d values\n", MAXVALUES);
+            exit(2);
+        }
+        l->v[l->n++] = atoi(t);
+    }
+}
+
+static void
+summarize (struct combo *c, const struct run *r)
+{
+    long n100 = 0, n1000 = 0;
+    long k;
+
+    c->locked = c->fallbacks = 0;
+    c->lock = c->adev100 = c->adev1000 = 0;
+    for (k = 0; k < pool.nruns; k++) {
+        if (r[k].slowlock >= 0) {
+            c->locked++;
+            c->lock += r[k].slowlock;
+        } else {
+            c->lock += pool.seconds;
+        }
+        c->fallbacks += r[k].fallbacks;
+        if (r[k].adev[0] >= 0) {
+            c->adev100 += r[k].adev[0];
+            n100++;
+        }
+        if (r[k].adev[1] >= 0) {
+            c->adev1000 += r[k].adev[1];
+            n1000++;
+        }
+    }
+    c->lock /= pool.nruns;
+    c->adev100 = n100 ? c->adev100 / n100 : -1;
+    c->adev1000 = n1000 ? c->adev1000 / n1000 : -1;
+}
+
+// a is no worse than b in lock time and stability, and better in one
+static int
+dominates (const struct combo *a, const struct combo *b)
+{
+    return a->lock <= b->lock && a->adev1000 <= b->adev1000
+        && (a->lock < b->lock || a->adev1000 < b->adev1000);
+}
+
+static int
+bylock (const void *x, const void *y)
+{
+    const struct combo *a = *(const struct combo **) x;
+    const struct combo *b = *(const struct combo **) y;
+
+    return a->lock < b->lock ? -1 : a->lock > b->lock;
+}
+
+static void
+usage (void)
+{
+    fprintf(stderr, "usage: sweep [-p profile] [-s seconds] [-n runs] [-w workers]\n"
+                    "             [-P list] [-I list] [-B list] [-E list]\n");
+    exit(2);
+}
+
+int
+main (int argc, char **argv)
+{
+    char p_def[] = "10,25,50,75,100", i_def[] = "5,10,25,50";
+    char b_def[] = "0,1,2", e_def[] = "0,1,2";
+    struct list lp, li, lb, le;
+    struct combo *c, **front;
+    struct gains *g;
+    struct run *runs;
+    long ncombos, nfront = 0;
+    long i, j;
+    int a, b, d, e;
+    int ch;
+
+    pool.workers = sysconf(_SC_NPROCESSORS_ONLN);
+    parse(&lp, p_def);
+    parse(&li, i_def);
+    parse(&lb, b_def);
+    parse(&le, e_def);
+
+    while ((ch = getopt(argc, argv, "p:s:n:w:P:I:B:E:")) != -1) {
+        switch (ch) {
+        case 'p':
+            for (pool.osc = osc_profiles; pool.osc->name; pool.osc++)
+                if (strcmp(pool.osc->name, optarg) == 0)
+                    break;
+            if (pool.osc->name == NULL) {
+                fprintf(stderr, "sweep: unknown profile %s\n", optarg);
+                exit(2);
+            }
+            break;
+        case 's':
+            pool.seconds = atol(optarg);
+            break;
+        case 'n':
+            pool.nruns = atol(optarg);
+            break;
+        case 'w':
+            pool.workers = atol(optarg);
+            break;
+        case 'P':
+            parse(&lp, optarg);
+            break;
+        case 'I':
+            parse(&li, optarg);
+            break;
+        case 'B':
+            parse(&lb, optarg);
+            break;
+        case 'E':
+            parse(&le, optarg);
+            break;
+        default:
+            usage();
+        }
+    }
+    if (pool.seconds <= 0 || pool.nruns <= 0)
+        usage();
+    pool.progress = isatty(2);
+
+    ncombos = (long) lp.n * li.n * lb.n * le.n;
+    c = calloc(ncombos, sizeof(*c));
+    g = calloc(ncombos, sizeof(*g));
+    front = calloc(ncombos, sizeof(*front));
+    runs = calloc(ncombos * pool.nruns, sizeof(*runs));
+    if (c == NULL || g == NULL || front == NULL || runs == NULL) {
+        perror("sweep");
+        exit(1);
+    }
+    i = 0;
+    for (a = 0; a < lp.n; a++)
+        for (b = 0; b < li.n; b++)
+            for (d = 0; d < lb.n; d++)
+                for (e = 0; e < le.n; e++, i++) {
+                    c[i].g = (struct gains) DEFAULT_GAINS;
+                    c[i].g.p_slow = lp.v[a];
+                    c[i].g.i_slow = li.v[b];
+                    c[i].g.p_band = lb.v[d];
+                    c[i].g.i_band = le.v[e];
+                }
+
+    fprintf(stderr, "sweep: %ld combinations x %ld runs of %ld seconds, %ld workers\n",
+            ncombos, pool.nruns, pool.seconds, pool.workers);
+    for (i = 0; i < ncombos; i++)
+        g[i] = c[i].g;
+    pool_run(&pool, g, ncombos, runs);
+
+    // Pareto front, of the combinations that locked in every run
+    for (i = 0; i < ncombos; i++)
+        summarize(&c[i], &runs[i * pool.nruns]);
+    for (i = 0; i < ncombos; i++) {
+        if (c[i].locked < pool.nruns || c[i].adev1000 < 0)
+            continue;
+        c[i].pareto = 1;
+        for (j = 0; j < ncombos && c[i].pareto; j++)
+            if (c[j].locked == pool.nruns && c[j].adev1000 >= 0 && dominates(&c[j], &c[i]))
+                c[i].pareto = 0;
+        if (c[i].pareto)
+            front[nfront++] = &c[i];
+    }
+
+    printf("p_slow,i_slow,p_band,i_band,locked,lock,fallbacks,adev100,adev1000,pareto\n");
+    for (i = 0; i < ncombos; i++)
+        printf("%d,%d,%d,%d,%ld,%.0f,%ld,%.3e,%.3e,%d\n",
+               c[i].g.p_slow, c[i].g.i_slow, c[i].g.p_band, c[i].g.i_band,
+               c[i].locked, c[i].lock, c[i].fallbacks, c[i].adev100,
+               c[i].adev1000, c[i].pareto);
+
+    qsort(front, nfront, sizeof(*front), bylock);
+    fprintf(stderr, "%6s %6s %6s %6s %8s %9s %10s %10s\n", "P", "I", "Pband",
+            "Iband", "lock s", "fallbacks", "adev100", "adev1000");
+    for (i = 0; i < nfront; i++)
+        fprintf(stderr, "%6d %6d %6d %6d %8.0f %9ld %10.3e %10.3e\n",
+                front[i]->g.p_slow, front[i]->g.i_slow, front[i]->g.p_band,
+                front[i]->g.i_band, front[i]->lock, front[i]->fallbacks,
+                front[i]->adev100, front[i]->adev1000);
+    return 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * timer.h - Timer 0 on the host, for the interrupt handler checks (isr.c)
+ *
+ * Copyright 2014-2017 Glen Overby
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Included by gpsdo.h in place of <msp430.h> when built with -DHOST_TIMER:
+ * the registers and bits the counter's handlers (common/counter.c) use,
+ * with the MSP430G2553's values.  The registers are variables that isr.c
+ * changes as the timer would.
+ */
+
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <stdint.h>
+
+extern volatile uint16_t TA0CTL, TA0R, TA0IV;
+extern volatile uint16_t TA0CCTL0, TA0CCTL1, TA0CCTL2;
+extern volatile uint16_t TA0CCR0, TA0CCR1, TA0CCR2;
+
+// TA0CTL
+#define TAIFG           0x0001
+#define TAIE            0x0002
+#define MC_2            0x0020
+
+// TA0CCTLn
+#define CCIFG           0x0001
+#define COV             0x0002
+#define OUT             0x0004
+#define CCI             0x0008
+#define CCIE            0x0010
+#define OUTMOD_0        0x0000
+#define OUTMOD_1        0x0020
+#define OUTMOD_5        0x00a0
+#define OUTMOD_7        0x00e0
+#define CAP             0x0100
+#define SCS             0x0800
+#define CM_1            0x4000
+#define CM_2            0x8000
+#define CM_3            0xc000
+#define CM1             CM_2
+
+// The handlers' reports turn interrupts off around their copies
+#define GIE             0x0008
+#define _BIC_SR(x)      ((void) (x))
+#define _BIS_SR(x)      ((void) (x))
+
+#endif /* TIMER_H */
@@ -0,0 +1,350 @@
+/*
+ * tune: find pid2 controller constants for an oscillator in the simulator
+ *
+ * Copyright 2014-2017 Glen Overby
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published
+ * by the Free Software Foundation
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * usage: tune [-p profile] [-s seconds] [-n runs] [-w workers] [-i evaluations]
+ *             [-B p-band] [-E i-band] [-L weight] [-F weight] [-o header]
+ *
+ *  -p  oscillator profile (default isotemp)
+ *  -s  seconds in each run (default 2 days)
+ *  -n  runs of each set of gains (default 8)
+ *  -w  worker processes (default one per processor)
+ *  -i  most sets of gains to try (default 60)
+ *  -B  P_ERRORBAND_SLOW (default isotemp.h's)
+ *  -E  I_ERRORBAND_SLOW (default isotemp.h's)
+ *  -L  cost of an hour to SLOW lock (default 1)
+ *  -F  cost of a SLOW -> FAST fallback (default 0.5)
+ *  -o  write the constants found to this header, for OSC_PROFILE
+ *
+ * P_FACTOR_FAST, P_FACTOR_SLOW and I_FACTOR_SLOW are searched with the
+ * Nelder-Mead simplex method on their logarithms, starting from
+ * isotemp.h's.  P_MAX_ERROR follows from P_FACTOR_FAST: the largest error
+ * whose FAST adjustment fits in an int.
+ *
+ * The cost of a set of gains is the mean over its runs (see pool.c) of
+ *
+ *   log10 of the Allan deviation at 100, 1000 and 10000 seconds, added
+ *   + L * hours to SLOW lock
+ *   + F * fallbacks
+ *   + UNLOCKED if the run never reached SLOW lock
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include "gpsdo.h"
+#include "pid2.h"
+#include "pool.h"
+
+#define NPARAM          3       // P_FACTOR_FAST, P_FACTOR_SLOW, I_FACTOR_SLOW
+#define UNLOCKED        10      // cost of a run that never locked
+#define MAXCACHE        512
+
+static struct pool pool = { osc_profiles, 2 * 86400, 8 };
+static double wlock = 1;
+static double wfallback = 0.5;
+static struct gains base = DEFAULT_GAINS;
+
+// Gains tried, so a point the simplex comes back to isn't run again
+static struct {
+    struct gains g;
+    double cost;
+    double lock, fallbacks, adev[NTAUS];
+} cache[MAXCACHE];
+static int ncache;
+static int maxeval = 60;
+
+static int16_t
+clamp (double v, int lo, int hi)
+{
+    v = floor(v + 0.5);
+    return v < lo ? lo : v > hi ? hi : v;
+}
+
+static struct gains
+params (const double *x)
+{
+    struct gains g = base;
+
+    g.p_fast = clamp(exp(x[0]), SAMPLE_SECONDS, 32767);
+    g.max_error = 32000 / (g.p_fast / SAMPLE_SECONDS);
+    g.p_slow = clamp(exp(x[1]), 1, 32767);
+    g.i_slow = clamp(exp(x[2]), 1, 32767);
+    return g;
+}
+
+// Runs the gains, or finds them in the cache.  Returns the cache slot.
+static int
+evaluate (const struct gains *g)
+{
+    struct run *r;
+    double c = 0;
+    int i, j, k;
+
+    for (i = 0; i < ncache; i++)
+        if (memcmp(&cache[i].g, g, sizeof(*g)) == 0)
+            return i;
+    if (ncache == MAXCACHE)
+        ncache--;               // reuse the last slot
+    i = ncache++;
+
+    r = calloc(pool.nruns, sizeof(*r));
+    if (r == NULL) {
+        perror("tune");
+        exit(1);
+    }
+    pool_run(&pool, g, 1, r);
+
+    memset(&cache[i], 0, sizeof(cache[i]));
+    cache[i].g = *g;
+    for (k = 0; k < pool.nruns; k++) {
+        if (r[k].slowlock < 0) {
+            c += UNLOCKED + wlock * pool.seconds / 3600.0;
+            cache[i].lock += pool.seconds;
+        } else {
+            c += wlock * r[k].slowlock / 3600.0;
+            cache[i].lock += r[k].slowlock;
+        }
+        c += wfallback * r[k].fallbacks;
+        cache[i].fallbacks += r[k].fallbacks;
+        for (j = 0; j < NTAUS; j++) {
+            // no deviation: as bad as 1e-8
+            c += log10(r[k].adev[j] > 0 ? r[k].adev[j] : 1e-8);
+            cache[i].adev[j] += r[k].adev[j] > 0 ? r[k].adev[j] : 1e-8;
+        }
+    }
+    cache[i].cost = c / pool.nruns;
+    cache[i].lock /= pool.nruns;
+    cache[i].fallbacks /= pool.nruns;
+    for (j = 0; j < NTAUS; j++)
+        cache[i].adev[j] /= pool.nruns;
+    free(r);
+
+    fprintf(stderr, "%3d  P_FAST %5d P_SLOW %5d I_SLOW %5d  lock %6.0f s  fallbacks %4.2f  adev %.2e %.2e %.2e  cost %7.3f\n",
+            i, g->p_fast, g->p_slow, g->i_slow, cache[i].lock,
+            cache[i].fallbacks, cache[i].adev[0], cache[i].adev[1],
+            cache[i].adev[2], cache[i].cost);
+    return i;
+}
+
+static double
+cost (const double *x)
+{
+    struct gains g = params(x);
+
+    return cache[evaluate(&g)].cost;
+}
+
+//
+// Nelder-Mead: reflect the worst point through the centroid of the others,
+// expanding or contracting the step, or shrink toward the best point.
+//
+static void
+simplex (double p[NPARAM + 1][NPARAM], double *f)
+{
+    double c[NPARAM], xr[NPARAM], xe[NPARAM];
+    double fr, fe;
+    int lo, hi, nh;
+    int i, j;
+
+    for (;;) {
+        lo = hi = 0;
+        for (i = 1; i <= NPARAM; i++) {
+            if (f[i] < f[lo])
+                lo = i;
+            if (f[i] > f[hi])
+                hi = i;
+        }
+        nh = lo;
+        for (i = 0; i <= NPARAM; i++)
+            if (i != hi && f[i] > f[nh])
+                nh = i;
+        if (ncache >= maxeval || f[hi] - f[lo] < 1e-3)
+            break;
+
+        for (j = 0; j < NPARAM; j++) {
+            c[j] = 0;
+            for (i = 0; i <= NPARAM; i++)
+                if (i != hi)
+                    c[j] += p[i][j] / NPARAM;
+            xr[j] = c[j] + (c[j] - p[hi][j]);
+        }
+        fr = cost(xr);
+
+        if (fr < f[lo]) {
+            for (j = 0; j < NPARAM; j++)
+                xe[j] = c[j] + 2 * (c[j] - p[hi][j]);
+            fe = cost(xe);
+            if (fe < fr) {
+                memcpy(p[hi], xe, sizeof(xe));
+                f[hi] = fe;
+            } else {
+                memcpy(p[hi], xr, sizeof(xr));
+                f[hi] = fr;
+            }
+        } else if (fr < f[nh]) {
+            memcpy(p[hi], xr, sizeof(xr));
+            f[hi] = fr;
+        } else {
+            // contract toward the better of the worst and its reflection
+            if (fr < f[hi]) {
+                memcpy(p[hi], xr, sizeof(xr));
+                f[hi] = fr;
+            }
+            for (j = 0; j < NPARAM; j++)
+                xe[j] = c[j] + 0.5 * (p[hi][j] - c[j]);
+            fe = cost(xe);
+            if (fe < f[hi]) {
+                memcpy(p[hi], xe, sizeof(xe));
+                f[hi] = fe;
+            } else {
+                for (i = 0; i <= NPARAM; i++) {
+                    if (i == lo)
+                        continue;
+                    for (j = 0; j < NPARAM; j++)
+                        p[i][j] = p[lo][j] + 0.5 * (p[i][j] - p[lo][j]);
+                    f[i] = cost(p[i]);
+                }
+            }
+        }
+    }
+}
+
+static void
+header (const char *file, int best, int built)
+{
+    FILE *f = fopen(file, "w");
+    const char *name = strrchr(file, '/') ? strrchr(file, '/') + 1 : file;
+    const struct gains *g = &cache[best].g;
+    char date[16];
+    time_t now = time(NULL);
+
+    if (f == NULL) {
+        perror(file);
+        exit(1);
+    }
+    strftime(date, sizeof(date), "%Y-%m-%d", localtime(&now));
+    fprintf(f, "/*\n"
+               " * %s - pid2 controller constants for the %s oscillator profile\n"
+               " *\n"
+               " * Found by sim/tune on %s from %d runs of %ld seconds.  The cost was\n"
+               " * %.3f, against %.3f for isotemp.h.\n"
+               " */\n\n",
+               name, pool.osc->name, date, (int) pool.nruns, pool.seconds,
+               cache[best].cost, cache[built].cost);
+    fprintf(f, "#define P_FACTOR_FAST   %d\n", g->p_fast);
+    fprintf(f, "#define P_ERRORBAND_FAST %d\n", P_ERRORBAND_FAST);
+    fprintf(f, "#define P_MAX_ERROR     %d     // 32000 / (P_FACTOR_FAST / SAMPLE_SECONDS)\n", g->max_error);
+    fprintf(f, "#define P_FACTOR_SLOW   %d\n", g->p_slow);
+    fprintf(f, "#define P_ERRORBAND_SLOW %d\n", g->p_band);
+    fprintf(f, "#define I_FACTOR_SLOW   %d\n", g->i_slow);
+    fprintf(f, "#define I_ERRORBAND_SLOW %d\n", g->i_band);
+    fprintf(f, "#define HAVE_GPSLOCK    %d\n", HAVE_GPSLOCK);
+    fprintf(f, "#define HAVE_OSCCOLD    %d\n", HAVE_OSCCOLD);
+    fclose(f);
+}
+
+static void
+usage (void)
+{
+    fprintf(stderr, "usage: tune [-p profile] [-s seconds] [-n runs] [-w workers] [-i evaluations]\n"
+                    "            [-B p-band] [-E i-band] [-L weight] [-F weight] [-o header]\n");
+    exit(2);
+}
+
+int
+main (int argc, char **argv)
+{
+    double p[NPARAM + 1][NPARAM], f[NPARAM + 1];
+    const char *out = NULL;
+    int built, best;
+    int i, ch;
+
+    pool.workers = sysconf(_SC_NPROCESSORS_ONLN);
+    while ((ch = getopt(argc, argv, "p:s:n:w:i:B:E:L:F:o:")) != -1) {
+        switch (ch) {
+        case 'p':
+            for (pool.osc = osc_profiles; pool.osc->name; pool.osc++)
+                if (strcmp(pool.osc->name, optarg) == 0)
+                    break;
+            if (pool.osc->name == NULL) {
+                fprintf(stderr, "tune: unknown profile %s\n", optarg);
+                exit(2);
+            }
+            break;
+        case 's':
+            pool.seconds = atol(optarg);
+            break;
+        case 'n':
+            pool.nruns = atol(optarg);
+            break;
+        case 'w':
+            pool.workers = atol(optarg);
+            break;
+        case 'i':
+            maxeval = atoi(optarg);
+            break;
+        case 'B':
+            base.p_band = atoi(optarg);
+            break;
+        case 'E':
+            base.i_band = atoi(optarg);
+            break;
+        case 'L':
+            wlock = atof(optarg);
+            break;
+        case 'F':
+            wfallback = atof(optarg);
+            break;
+        case 'o':
+            out = optarg;
+            break;
+        default:
+            usage();
+        }
+    }
+    if (pool.seconds <= 0 || pool.nruns <= 0 || maxeval > MAXCACHE)
+        usage();
+
+    // The constants as built, then the starting simplex: those, and each
+    // doubled
+    built = evaluate(&base);
+    for (i = 0; i <= NPARAM; i++) {
+        p[i][0] = log(base.p_fast);
+        p[i][1] = log(base.p_slow);
+        p[i][2] = log(base.i_slow);
+        if (i > 0)
+            p[i][i - 1] += log(2);
+        f[i] = cost(p[i]);
+    }
+    simplex(p, f);
+
+    best = 0;
+    for (i = 1; i < ncache; i++)
+        if (cache[i].cost < cache[best].cost)
+            best = i;
+    printf("P_FACTOR_FAST %d P_MAX_ERROR %d P_FACTOR_SLOW %d I_FACTOR_SLOW %d"
+           " P_ERRORBAND_SLOW %d I_ERRORBAND_SLOW %d cost %.3f as-built %.3f\n",
+           cache[best].g.p_fast, cache[best].g.max_error, cache[best].g.p_slow,
+           cache[best].g.i_slow, cache[best].g.p_band, cache[best].g.i_band,
+           cache[best].cost, cache[built].cost);
+    if (out)
+        header(out, best, built);
+    return 0;
+}